@@ -131,7 +131,8 @@ const NewPdfViewer = () => {
             stageWidth * 2,
             tileWidth,
             tileHeight,
-            zoomFactor);
+            zoomFactor,
+            'rgbx');
     
         const data = Skia.Data.fromBytes(new Uint8Array(tileBuf));
         const img = Skia.Image.MakeImage(
@@ -139,7 +140,7 @@ const NewPdfViewer = () => {
             width: tileWidth,
             height: tileHeight,
             alphaType: AlphaType.Opaque,
-            colorType: USE_BGR565 ? ColorType.RGB_565 : ColorType.RGBA_8888,
+            colorType: USE_BGR565 ? ColorType.RGB_565 : ColorType.RGB_888x,
           },
           data,
           tileWidth * (USE_BGR565 ? 2 : 4)
@@ -279,7 +279,8 @@ const PdfViewer = () => {
         width,
         tileWidth,
         tileHeight,
-        zoomFactor);
+        zoomFactor,
+        'rgbx');
 
     const data = Skia.Data.fromBytes(new Uint8Array(tileBuf));
     const img = Skia.Image.MakeImage(
@@ -287,7 +288,7 @@ const PdfViewer = () => {
         width: tileWidth,
         height: tileHeight,
         alphaType: AlphaType.Opaque,
-        colorType: USE_BGR565 ? ColorType.RGB_565 : ColorType.RGBA_8888,
+        colorType: USE_BGR565 ? ColorType.RGB_565 : ColorType.RGB_888x,
       },
       data,
       tileWidth * (USE_BGR565 ? 2 : 4)
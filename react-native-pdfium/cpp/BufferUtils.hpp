@@ -0,0 +1,23 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <NitroModules/ArrayBuffer.hpp>
+
+namespace margelo::nitro::pdfium {
+
+    // Allocates a buffer that is released once JS garbage collects it
+    inline std::shared_ptr<ArrayBuffer> allocateBuffer(size_t size) {
+        uint8_t* stream = new uint8_t[std::max(size, (size_t)1)];
+        return ArrayBuffer::wrap(stream, size, [=]() {
+            delete[] stream;
+        });
+    }
+
+    inline std::shared_ptr<ArrayBuffer> copyToBuffer(const void* data, size_t size) {
+        std::shared_ptr<ArrayBuffer> buffer = allocateBuffer(size);
+        std::memcpy(buffer->data(), data, size);
+        return buffer;
+    }
+}
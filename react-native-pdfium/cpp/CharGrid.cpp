@@ -0,0 +1,150 @@
+#include "CharGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace margelo::nitro::pdfium {
+
+    // Average number of characters per cell the grid is sized for
+    static constexpr double kCharsPerCell = 4.0;
+    static constexpr int kMaxCellsPerAxis = 256;
+
+    CharGrid::CharGrid(FPDF_TEXTPAGE textPage, const PageTransform& transform, double pageWidth, double pageHeight) {
+        int count = textPage ? FPDFText_CountChars(textPage) : 0;
+        m_boxes.resize(std::max(count, 0), Box{0, 0, 0, 0});
+
+        int placedChars = 0;
+        for (int i = 0; i < count; i++) {
+            FS_RECTF rect;
+            if (!FPDFText_GetLooseCharBox(textPage, i, &rect)) {
+                continue;
+            }
+            // From PDF space to the displayed page used by the viewer
+            Box box;
+            transform.toDisplay(rect.left, rect.top, rect.right, rect.bottom, box.left, box.top, box.right, box.bottom);
+            if (box.right <= box.left || box.bottom <= box.top) {
+                continue;
+            }
+            m_boxes[i] = box;
+            placedChars++;
+        }
+
+        // Size the grid to the page aspect ratio so cells are roughly square
+        double width = std::max(pageWidth, 1.0);
+        double height = std::max(pageHeight, 1.0);
+        double cells = std::max(placedChars / kCharsPerCell, 1.0);
+        m_columns = std::clamp((int)std::lround(std::sqrt(cells * width / height)), 1, kMaxCellsPerAxis);
+        m_rows = std::clamp((int)std::lround(std::sqrt(cells * height / width)), 1, kMaxCellsPerAxis);
+        m_cellWidth = width / m_columns;
+        m_cellHeight = height / m_rows;
+
+        // Two passes: count the characters per cell, then fill the flat array
+        m_cellStart.assign(m_columns * m_rows + 1, 0);
+        for (int pass = 0; pass < 2; pass++) {
+            std::vector<uint32_t> cursor;
+            if (pass == 1) {
+                for (size_t c = 1; c < m_cellStart.size(); c++) {
+                    m_cellStart[c] += m_cellStart[c - 1];
+                }
+                m_cellChars.resize(m_cellStart.back());
+                cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+            }
+
+            for (int i = 0; i < count; i++) {
+                const Box& box = m_boxes[i];
+                if (box.right <= box.left) {
+                    continue;
+                }
+                int c0 = cellColumn(box.left), c1 = cellColumn(box.right);
+                int r0 = cellRow(box.top), r1 = cellRow(box.bottom);
+                for (int r = r0; r <= r1; r++) {
+                    for (int c = c0; c <= c1; c++) {
+                        int cell = r * m_columns + c;
+                        if (pass == 0) {
+                            m_cellStart[cell + 1]++;
+                        } else {
+                            m_cellChars[cursor[cell]++] = (uint32_t)i;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    int CharGrid::cellColumn(double x) const {
+        return std::clamp((int)std::floor(x / m_cellWidth), 0, m_columns - 1);
+    }
+
+    int CharGrid::cellRow(double y) const {
+        return std::clamp((int)std::floor(y / m_cellHeight), 0, m_rows - 1);
+    }
+
+    int CharGrid::charIndexAt(double x, double y, double tolerance) const {
+        tolerance = std::max(tolerance, 0.0);
+        int c0 = cellColumn(x - tolerance), c1 = cellColumn(x + tolerance);
+        int r0 = cellRow(y - tolerance), r1 = cellRow(y + tolerance);
+
+        int best = -1;
+        double bestDistance = std::numeric_limits<double>::max();
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                int cell = r * m_columns + c;
+                for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; k++) {
+                    uint32_t i = m_cellChars[k];
+                    const Box& box = m_boxes[i];
+                    double dx = std::max({box.left - x, 0.0, x - box.right});
+                    double dy = std::max({box.top - y, 0.0, y - box.bottom});
+                    double distance = std::sqrt(dx * dx + dy * dy);
+                    if (distance <= tolerance && (distance < bestDistance || (distance == bestDistance && (int)i < best))) {
+                        best = (int)i;
+                        bestDistance = distance;
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    std::vector<int32_t> CharGrid::charRangesInRect(double left, double top, double right, double bottom) const {
+        std::vector<int32_t> ranges;
+        if (right < left) std::swap(left, right);
+        if (bottom < top) std::swap(top, bottom);
+
+        std::vector<uint32_t> hits;
+        int c0 = cellColumn(left), c1 = cellColumn(right);
+        int r0 = cellRow(top), r1 = cellRow(bottom);
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                int cell = r * m_columns + c;
+                for (uint32_t k = m_cellStart[cell]; k < m_cellStart[cell + 1]; k++) {
+                    const Box& box = m_boxes[m_cellChars[k]];
+                    if (box.left <= right && box.right >= left && box.top <= bottom && box.bottom >= top) {
+                        hits.push_back(m_cellChars[k]);
+                    }
+                }
+            }
+        }
+
+        // Characters spanning several cells show up more than once
+        std::sort(hits.begin(), hits.end());
+        hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+
+        for (uint32_t i : hits) {
+            if (!ranges.empty()) {
+                // Extend the previous range when only characters without geometry (generated
+                // spaces and line breaks) separate it from this one
+                uint32_t end = (uint32_t)(ranges[ranges.size() - 2] + ranges.back());
+                while (end < i && m_boxes[end].right <= m_boxes[end].left) {
+                    end++;
+                }
+                if (end == i) {
+                    ranges.back() = (int32_t)(i + 1) - ranges[ranges.size() - 2];
+                    continue;
+                }
+            }
+            ranges.push_back((int32_t)i);
+            ranges.push_back(1);
+        }
+        return ranges;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "fpdf_text.h"
+#include "PageTransform.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // Uniform grid over the character boxes of a text page. Each cell lists the characters
+    // whose loose box overlaps it, stored as one flat array with per-cell offsets. Built once
+    // per text page, queries then only look at the few characters around the query point
+    // instead of scanning the whole page like FPDFText_GetCharIndexAtPos does.
+    //
+    // All coordinates are page points with a top-left origin, as the page is displayed.
+    class CharGrid {
+        public:
+            CharGrid(FPDF_TEXTPAGE textPage, const PageTransform& transform, double pageWidth, double pageHeight);
+
+            // Returns the character under (x, y), or the closest one within `tolerance`.
+            // Returns -1 if there is none.
+            int charIndexAt(double x, double y, double tolerance) const;
+
+            // Returns the characters overlapping the rect as sorted [start, count] pairs, with
+            // adjacent characters merged into one range.
+            std::vector<int32_t> charRangesInRect(double left, double top, double right, double bottom) const;
+
+            int charCount() const { return (int)m_boxes.size(); }
+
+            struct Box {
+                float left;
+                float top;
+                float right;
+                float bottom;
+            };
+            // Loose box of a character. Characters without geometry have an empty box.
+            const Box& boxOf(int charIndex) const { return m_boxes[charIndex]; }
+
+        private:
+            int cellColumn(double x) const;
+            int cellRow(double y) const;
+
+            std::vector<Box> m_boxes;
+            int m_columns = 1;
+            int m_rows = 1;
+            double m_cellWidth = 1;
+            double m_cellHeight = 1;
+            std::vector<uint32_t> m_cellStart; // m_columns * m_rows + 1 offsets into m_cellChars
+            std::vector<uint32_t> m_cellChars;
+    };
+}
@@ -0,0 +1,512 @@
+#include "DiskTileCache.hpp"
+#include "BufferUtils.hpp"
+#include "Hashing.hpp"
+#include "TileCompression.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace margelo::nitro::pdfium {
+
+    static constexpr uint32_t kSegmentMagic = 0x43544450; // "PDTC"
+    static constexpr uint32_t kIndexMagic = 0x49544450;   // "PDTI"
+    static constexpr uint32_t kRecordMagic = 0x52544450;  // "PDTR"
+    static constexpr uint32_t kVersion = 2;
+    // Compaction keeps this share of the cap so it does not run again right away
+    static constexpr double kCompactedShare = 0.75;
+    // Tiles put while this many wait for the writer are dropped rather than queued
+    static constexpr size_t kMaxPendingTiles = 64;
+
+    struct SegmentHeader {
+        uint32_t magic;
+        uint32_t version;
+    };
+
+    // Precedes each tile in the segment. Records are padded to 8 bytes.
+    struct RecordHeader {
+        uint32_t magic;
+        uint32_t recordSize;    // Header, pixels, palette and padding
+        uint64_t document;
+        uint64_t colorScheme;
+        double row;
+        double column;
+        double scale;
+        double uniformColor;
+        int32_t page;
+        int32_t keyWidth;
+        int32_t keyHeight;
+        int32_t pixelFormat;
+        int32_t colorMode;
+        int32_t quality;
+        int32_t width;
+        int32_t height;
+        int32_t rowBytes;
+        int32_t colorType;
+        int32_t unitSize;       // 0 if the pixels are stored as is
+        uint32_t pixelsSize;    // Size of the decoded pixels
+        uint32_t dataSize;      // Stored pixel bytes
+        uint32_t paletteSize;
+        uint32_t hasUniformColor;
+        uint32_t checksum;      // Of the header, with this field 0, and the data and palette
+    };
+    static_assert(sizeof(RecordHeader) % 8 == 0, "Records must stay 8 byte aligned");
+
+    struct IndexHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t segmentSize;
+        uint64_t count;
+    };
+
+    struct IndexEntry {
+        uint64_t offset;
+        uint64_t lastAccess;
+    };
+
+    static size_t align8(size_t size) {
+        return (size + 7) & ~(size_t)7;
+    }
+
+    // Checks that the sizes a record claims fit within it and agree with each other, so that a
+    // damaged segment can neither make a read run past the record nor size a huge allocation.
+    // A run decodes to at most 129 units from 2 bytes or more, which bounds the pixels.
+    static bool isValidRecord(const RecordHeader& header, uint64_t size) {
+        if (header.magic != kRecordMagic || header.recordSize != size ||
+            sizeof(header) + (uint64_t)header.dataSize + header.paletteSize > size) {
+            return false;
+        }
+        if (header.width <= 0 || header.height <= 0) {
+            return false;
+        }
+        // Uniform tiles are stored as their header alone
+        if (header.hasUniformColor) {
+            return header.unitSize == 0 && header.pixelsSize == 0 && header.dataSize == 0 && header.paletteSize == 0;
+        }
+        if (header.rowBytes <= 0 || (uint64_t)header.rowBytes * header.height != header.pixelsSize) {
+            return false;
+        }
+        if (header.unitSize == 0) {
+            return header.dataSize == header.pixelsSize;
+        }
+        return (header.unitSize == 1 || header.unitSize == 4) &&
+               header.pixelsSize <= (uint64_t)header.dataSize * 129;
+    }
+
+    // Checked when the segment is scanned on open, to catch records torn by a crash mid write
+    static uint32_t computeChecksum(const RecordHeader& header, const uint8_t* payload) {
+        RecordHeader unchecked = header;
+        unchecked.checksum = 0;
+        uint64_t hash = hashValue(kHashSeed, unchecked);
+        hash = hashBytes(hash, payload, (size_t)header.dataSize + header.paletteSize);
+        return (uint32_t)(hash ^ (hash >> 32));
+    }
+
+    bool DiskTileCache::open(const std::string& directory, size_t maxBytes) {
+        close();
+        if (maxBytes == 0) {
+            std::cerr << "The tile cache needs a size above 0" << std::endl;
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ::mkdir(directory.c_str(), 0755);
+        m_segmentPath = directory + "/tiles.seg";
+        m_indexPath = directory + "/tiles.idx";
+        m_maxBytes = maxBytes;
+
+        m_fd = ::open(m_segmentPath.c_str(), O_RDWR | O_CREAT, 0644);
+        if (m_fd < 0) {
+            std::cerr << "Failed to open the tile cache at " << m_segmentPath << std::endl;
+            return false;
+        }
+        struct stat info;
+        SegmentHeader header{};
+        if (fstat(m_fd, &info) != 0 || info.st_size < (off_t)sizeof(SegmentHeader) ||
+            pread(m_fd, &header, sizeof(header), 0) != sizeof(header) ||
+            header.magic != kSegmentMagic || header.version != kVersion) {
+            // Missing or written by another version, start over
+            header = {kSegmentMagic, kVersion};
+            if (ftruncate(m_fd, 0) != 0 || pwrite(m_fd, &header, sizeof(header), 0) != sizeof(header)) {
+                ::close(m_fd);
+                m_fd = -1;
+                return false;
+            }
+            m_segmentSize = sizeof(header);
+        } else {
+            m_segmentSize = info.st_size;
+        }
+
+        scanSegment();
+        if (!m_map) {
+            std::cerr << "Failed to map the tile cache at " << m_segmentPath << std::endl;
+            ::close(m_fd);
+            m_fd = -1;
+            return false;
+        }
+        loadIndex();
+
+        std::lock_guard<std::mutex> writeLock(m_writeMutex);
+        m_stopRequested = false;
+        m_writeFailed = false;
+        m_writer = std::thread(&DiskTileCache::run, this);
+        return true;
+    }
+
+    void DiskTileCache::close() {
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            m_stopRequested = true;
+        }
+        m_writeCondition.notify_one();
+        if (m_writer.joinable()) {
+            m_writer.join();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_fd < 0) {
+            return;
+        }
+        saveIndex();
+        unmapSegment();
+        ::close(m_fd);
+        m_fd = -1;
+        m_entries.clear();
+    }
+
+    bool DiskTileCache::mapSegment() {
+        unmapSegment();
+        // Mapped up to the cap so that appends rarely need a new mapping. Only records already
+        // written are read, never the part past the end of the file.
+        size_t size = std::max((size_t)m_segmentSize, m_maxBytes);
+        void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+        if (map == MAP_FAILED && size > m_segmentSize) {
+            // A large cap may not fit the address space of a 32 bit process, map just the file
+            size = m_segmentSize;
+            map = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+        }
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        m_map = (uint8_t*)map;
+        m_mapSize = size;
+        return true;
+    }
+
+    void DiskTileCache::unmapSegment() {
+        if (m_map) {
+            munmap(m_map, m_mapSize);
+            m_map = nullptr;
+            m_mapSize = 0;
+        }
+    }
+
+    void DiskTileCache::scanSegment() {
+        m_entries.clear();
+        if (!mapSegment()) {
+            return;
+        }
+        uint64_t offset = sizeof(SegmentHeader);
+        while (offset + sizeof(RecordHeader) <= m_segmentSize) {
+            RecordHeader header;
+            std::memcpy(&header, m_map + offset, sizeof(header));
+            if (header.magic != kRecordMagic || header.recordSize < sizeof(header) ||
+                offset + header.recordSize > m_segmentSize) {
+                break;
+            }
+            // A later record for the same key replaces the earlier one
+            EntryKey key{header.document, TileKey{header.page, header.row, header.column, header.keyWidth, header.keyHeight,
+                                                  header.scale, header.pixelFormat, header.colorMode, header.quality, header.colorScheme}};
+            if (isValidRecord(header, header.recordSize) &&
+                computeChecksum(header, m_map + offset + sizeof(header)) == header.checksum) {
+                m_entries[key] = Entry{offset, header.recordSize, ++m_clock};
+            } else {
+                m_entries.erase(key);
+            }
+            offset += header.recordSize;
+        }
+        if (offset < m_segmentSize) {
+            // Drop a record torn by a crash mid write
+            std::cerr << "Truncating the tile cache at " << offset << std::endl;
+            m_segmentSize = offset;
+            if (ftruncate(m_fd, offset) != 0) {
+                std::cerr << "Failed to truncate the tile cache" << std::endl;
+            }
+            mapSegment();
+        }
+    }
+
+    void DiskTileCache::loadIndex() {
+        FILE* file = fopen(m_indexPath.c_str(), "rb");
+        if (!file) {
+            return;
+        }
+        IndexHeader header;
+        if (fread(&header, sizeof(header), 1, file) == 1 && header.magic == kIndexMagic &&
+            header.version == kVersion && header.segmentSize == m_segmentSize) {
+            std::vector<IndexEntry> saved(header.count);
+            if (fread(saved.data(), sizeof(IndexEntry), saved.size(), file) == saved.size()) {
+                std::unordered_map<uint64_t, uint64_t> accessByOffset;
+                for (const IndexEntry& entry : saved) {
+                    accessByOffset[entry.offset] = entry.lastAccess;
+                    m_clock = std::max(m_clock, entry.lastAccess);
+                }
+                for (auto& [key, entry] : m_entries) {
+                    auto it = accessByOffset.find(entry.offset);
+                    if (it != accessByOffset.end()) {
+                        entry.lastAccess = it->second;
+                    }
+                }
+            }
+        }
+        fclose(file);
+    }
+
+    void DiskTileCache::saveIndex() {
+        std::string tempPath = m_indexPath + ".tmp";
+        FILE* file = fopen(tempPath.c_str(), "wb");
+        if (!file) {
+            return;
+        }
+        IndexHeader header{kIndexMagic, kVersion, m_segmentSize, m_entries.size()};
+        std::vector<IndexEntry> entries;
+        entries.reserve(m_entries.size());
+        for (const auto& [key, entry] : m_entries) {
+            entries.push_back({entry.offset, entry.lastAccess});
+        }
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       fwrite(entries.data(), sizeof(IndexEntry), entries.size(), file) == entries.size();
+        fclose(file);
+        if (written) {
+            std::rename(tempPath.c_str(), m_indexPath.c_str());
+        }
+    }
+
+    std::optional<RenderedTile> DiskTileCache::get(uint64_t document, const TileKey& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(EntryKey{document, key});
+        if (it == m_entries.end()) {
+            return std::nullopt;
+        }
+        Entry& entry = it->second;
+        if (!m_map || entry.offset + entry.size > m_mapSize) {
+            return std::nullopt;
+        }
+
+        RecordHeader header;
+        const uint8_t* record = m_map + entry.offset;
+        std::memcpy(&header, record, sizeof(header));
+        if (!isValidRecord(header, entry.size)) {
+            std::cerr << "Dropping a corrupt tile from the tile cache" << std::endl;
+            m_entries.erase(it);
+            return std::nullopt;
+        }
+        const uint8_t* data = record + sizeof(header);
+        std::shared_ptr<ArrayBuffer> buffer = allocateBuffer(header.pixelsSize);
+        uint8_t* pixels = buffer->data();
+        if (header.unitSize == 0) {
+            std::memcpy(pixels, data, header.pixelsSize);
+        } else if (!decompressRle(data, header.dataSize, header.unitSize, pixels, header.pixelsSize)) {
+            m_entries.erase(it);
+            return std::nullopt;
+        }
+
+        std::optional<std::shared_ptr<ArrayBuffer>> palette;
+        if (header.paletteSize > 0) {
+            palette = copyToBuffer(data + header.dataSize, header.paletteSize);
+        }
+        std::optional<double> uniformColor;
+        if (header.hasUniformColor) {
+            uniformColor = header.uniformColor;
+        }
+        entry.lastAccess = ++m_clock;
+        m_hits++;
+        return RenderedTile(buffer, header.width, header.height, header.rowBytes, (TileColorType)header.colorType,
+                            palette, uniformColor, (TileQuality)key.quality);
+    }
+
+    void DiskTileCache::put(uint64_t document, const TileKey& key, const RenderedTile& tile) {
+        // Tiles of pages that failed to load have no size, and nothing worth keeping
+        if (tile.width <= 0 || tile.height <= 0 || (!tile.uniformColor && tile.buffer->size() == 0)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (!m_writer.joinable() || m_stopRequested || m_writeFailed || m_pending.size() >= kMaxPendingTiles) {
+            return;
+        }
+        m_pending.push_back(PendingTile{EntryKey{document, key}, tile});
+        m_writeCondition.notify_one();
+    }
+
+    void DiskTileCache::run() {
+        while (true) {
+            std::vector<PendingTile> tiles;
+            {
+                std::unique_lock<std::mutex> lock(m_writeMutex);
+                m_writeCondition.wait(lock, [this] { return m_stopRequested || !m_pending.empty(); });
+                // Tiles queued before close() are still written
+                if (m_pending.empty()) {
+                    return;
+                }
+                tiles.swap(m_pending);
+            }
+            write(tiles);
+        }
+    }
+
+    // Only the writer thread appends to the segment or replaces it, so it writes the file and
+    // reads the mapping without m_mutex, taking it just to publish the result to get().
+    void DiskTileCache::write(std::vector<PendingTile>& tiles) {
+        std::vector<uint8_t> records;
+        std::vector<std::pair<EntryKey, Entry>> written;
+        uint64_t offset = m_segmentSize;
+        for (const PendingTile& pending : tiles) {
+            const TileKey& key = pending.key.tile;
+            const RenderedTile& tile = pending.tile;
+            int unitSize = getRleUnitSize(tile.colorType);
+            size_t pixelsSize = tile.buffer->size();
+            std::vector<uint8_t> data = compressRle(tile.buffer->data(), pixelsSize, unitSize);
+            if (data.size() >= pixelsSize) {
+                data.assign(tile.buffer->data(), tile.buffer->data() + pixelsSize);
+                unitSize = 0;
+            }
+            size_t paletteSize = tile.palette ? (*tile.palette)->size() : 0;
+
+            RecordHeader header{};
+            header.magic = kRecordMagic;
+            header.recordSize = (uint32_t)align8(sizeof(header) + data.size() + paletteSize);
+            header.document = pending.key.document;
+            header.colorScheme = key.colorScheme;
+            header.row = key.row;
+            header.column = key.column;
+            header.scale = key.scale;
+            header.uniformColor = tile.uniformColor.value_or(0);
+            header.page = key.page;
+            header.keyWidth = key.width;
+            header.keyHeight = key.height;
+            header.pixelFormat = key.pixelFormat;
+            header.colorMode = key.colorMode;
+            header.quality = key.quality;
+            header.width = (int32_t)tile.width;
+            header.height = (int32_t)tile.height;
+            header.rowBytes = (int32_t)tile.rowBytes;
+            header.colorType = (int32_t)tile.colorType;
+            header.unitSize = unitSize;
+            header.pixelsSize = (uint32_t)pixelsSize;
+            header.dataSize = (uint32_t)data.size();
+            header.paletteSize = (uint32_t)paletteSize;
+            header.hasUniformColor = tile.uniformColor.has_value();
+
+            size_t recordStart = records.size();
+            records.resize(recordStart + header.recordSize, 0);
+            uint8_t* record = records.data() + recordStart;
+            std::memcpy(record, &header, sizeof(header));
+            std::copy(data.begin(), data.end(), record + sizeof(header));
+            if (paletteSize > 0) {
+                std::memcpy(record + sizeof(header) + data.size(), (*tile.palette)->data(), paletteSize);
+            }
+            header.checksum = computeChecksum(header, record + sizeof(header));
+            std::memcpy(record, &header, sizeof(header));
+            written.emplace_back(pending.key, Entry{offset, header.recordSize, 0});
+            offset += header.recordSize;
+        }
+
+        if (pwrite(m_fd, records.data(), records.size(), m_segmentSize) != (ssize_t)records.size()) {
+            std::cerr << "Failed to write to the tile cache" << std::endl;
+            return;
+        }
+        bool full;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            uint64_t previousSize = m_segmentSize;
+            m_segmentSize = offset;
+            if (m_segmentSize > m_mapSize && !mapSegment()) {
+                // Tiles that can not be mapped can not be read or compacted either. Drop them and
+                // stop writing, rather than let the segment grow past the cap.
+                std::cerr << "Failed to map the tile cache, no longer writing to it" << std::endl;
+                m_segmentSize = previousSize;
+                if (ftruncate(m_fd, previousSize) != 0) {
+                    std::cerr << "Failed to truncate the tile cache" << std::endl;
+                }
+                mapSegment();
+                std::lock_guard<std::mutex> writeLock(m_writeMutex);
+                m_writeFailed = true;
+                m_pending.clear();
+                return;
+            }
+            for (auto& [key, entry] : written) {
+                entry.lastAccess = ++m_clock;
+                m_entries[key] = entry;
+            }
+            full = m_segmentSize > m_maxBytes;
+        }
+        if (full) {
+            compact();
+        }
+    }
+
+    void DiskTileCache::compact() {
+        std::vector<std::pair<EntryKey, Entry>> entries;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_map) {
+                return;
+            }
+            entries.assign(m_entries.begin(), m_entries.end());
+        }
+        std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+            return a.second.lastAccess > b.second.lastAccess;
+        });
+
+        std::string tempPath = m_segmentPath + ".tmp";
+        int fd = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return;
+        }
+        SegmentHeader header{kSegmentMagic, kVersion};
+        uint64_t size = sizeof(header);
+        bool written = pwrite(fd, &header, sizeof(header), 0) == sizeof(header);
+        std::unordered_map<EntryKey, Entry, EntryKeyHash> kept;
+        for (const auto& [key, entry] : entries) {
+            if (!written || size + entry.size > m_maxBytes * kCompactedShare) {
+                break;
+            }
+            written = pwrite(fd, m_map + entry.offset, entry.size, size) == (ssize_t)entry.size;
+            kept[key] = Entry{size, entry.size, entry.lastAccess};
+            size += entry.size;
+        }
+        if (!written || std::rename(tempPath.c_str(), m_segmentPath.c_str()) != 0) {
+            ::close(fd);
+            std::remove(tempPath.c_str());
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Keep the accesses get() made meanwhile, and leave out tiles it dropped as corrupt
+        for (auto it = kept.begin(); it != kept.end();) {
+            auto current = m_entries.find(it->first);
+            if (current == m_entries.end()) {
+                it = kept.erase(it);
+            } else {
+                it->second.lastAccess = current->second.lastAccess;
+                ++it;
+            }
+        }
+        unmapSegment();
+        ::close(m_fd);
+        m_fd = fd;
+        m_segmentSize = size;
+        m_entries = std::move(kept);
+        mapSegment();
+        saveIndex();
+    }
+
+    DiskTileCacheStats DiskTileCache::getStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return DiskTileCacheStats{m_entries.size(), (size_t)m_segmentSize, m_hits};
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "RenderedTile.hpp"
+#include "TileKey.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    struct DiskTileCacheStats {
+        size_t tiles = 0;
+        size_t bytes = 0;
+        size_t hits = 0;
+    };
+
+    // Tiles persisted across app launches, shared by all documents and keyed by document
+    // fingerprint plus TileKey. Tiles are appended run-length compressed to a segment file
+    // that is memory-mapped for reads. The index of records is rebuilt by walking the segment
+    // headers on open, and their access order restored from a small index file. Once the
+    // segment outgrows its cap, the most recently used tiles are copied to a fresh segment and
+    // the rest dropped. Writes and compaction run on a writer thread, so neither put() nor
+    // get() waits on the disk.
+    class DiskTileCache {
+        public:
+            DiskTileCache() = default;
+            DiskTileCache(const DiskTileCache&) = delete;
+            DiskTileCache& operator=(const DiskTileCache&) = delete;
+            ~DiskTileCache() { close(); }
+
+            bool open(const std::string& directory, size_t maxBytes);
+            // Saves the index and releases the files
+            void close();
+
+            std::optional<RenderedTile> get(uint64_t document, const TileKey& key);
+            // Queues the tile for the writer thread. Uniform tiles are persisted as their color
+            // alone. Tiles put while the writer is too far behind are dropped.
+            void put(uint64_t document, const TileKey& key, const RenderedTile& tile);
+            DiskTileCacheStats getStats();
+
+        private:
+            struct EntryKey {
+                uint64_t document;
+                TileKey tile;
+
+                bool operator==(const EntryKey& other) const {
+                    return document == other.document && tile == other.tile;
+                }
+            };
+
+            struct EntryKeyHash {
+                size_t operator()(const EntryKey& key) const {
+                    return std::hash<TileKey>()(key.tile) ^ (std::hash<uint64_t>()(key.document) * 31);
+                }
+            };
+
+            struct Entry {
+                uint64_t offset;
+                uint32_t size;
+                uint64_t lastAccess;
+            };
+
+            struct PendingTile {
+                EntryKey key;
+                RenderedTile tile;
+            };
+
+            bool mapSegment();
+            void unmapSegment();
+            void scanSegment();
+            void loadIndex();
+            void saveIndex();
+            void run();
+            void write(std::vector<PendingTile>& tiles);
+            void compact();
+
+            std::mutex m_mutex; // Guards the index and the mapping
+            std::thread m_writer;
+            std::mutex m_writeMutex; // Guards the tiles waiting to be written
+            std::condition_variable m_writeCondition;
+            std::vector<PendingTile> m_pending;
+            bool m_stopRequested = false;
+            bool m_writeFailed = false; // The segment could not be mapped, puts are dropped
+            std::string m_segmentPath;
+            std::string m_indexPath;
+            size_t m_maxBytes = 0;
+            int m_fd = -1;
+            uint8_t* m_map = nullptr;
+            size_t m_mapSize = 0;
+            uint64_t m_segmentSize = 0;
+            uint64_t m_clock = 0; // Access counter ordering the entries for compaction
+            std::unordered_map<EntryKey, Entry, EntryKeyHash> m_entries;
+            size_t m_hits = 0;
+    };
+}
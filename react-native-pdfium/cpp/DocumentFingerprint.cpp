@@ -0,0 +1,43 @@
+#include "DocumentFingerprint.hpp"
+#include "Hashing.hpp"
+#include "fpdf_doc.h"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace margelo::nitro::pdfium {
+
+    // Bytes hashed from each end of files without an /ID
+    static constexpr size_t kSampleSize = 64 * 1024;
+
+    uint64_t computeDocumentFingerprint(FPDF_DOCUMENT document, const std::string& filePath) {
+        uint64_t hash = kHashSeed;
+        std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+        uint64_t fileSize = file ? (uint64_t)file.tellg() : 0;
+        hash = hashValue(hash, fileSize);
+
+        // The permanent id survives edits, the changing one is rewritten by each of them
+        bool hasId = false;
+        for (FPDF_FILEIDTYPE type : {FILEIDTYPE_PERMANENT, FILEIDTYPE_CHANGING}) {
+            unsigned long length = FPDF_GetFileIdentifier(document, type, nullptr, 0);
+            if (length > 1) {
+                std::vector<char> id(length);
+                FPDF_GetFileIdentifier(document, type, id.data(), length);
+                hash = hashBytes(hash, id.data(), length - 1);
+                hasId = true;
+            }
+        }
+
+        if (!hasId && file) {
+            std::vector<char> sample(std::min<uint64_t>(kSampleSize, fileSize));
+            file.seekg(0);
+            file.read(sample.data(), sample.size());
+            hash = hashBytes(hash, sample.data(), file.gcount());
+            file.clear();
+            file.seekg(fileSize - sample.size());
+            file.read(sample.data(), sample.size());
+            hash = hashBytes(hash, sample.data(), file.gcount());
+        }
+        return hash == 0 ? 1 : hash;
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "fpdfview.h"
+
+namespace margelo::nitro::pdfium {
+
+    // Identifies a PDF file across app launches. Based on the trailer /ID pair and the file
+    // size, or, for files without an /ID, on a hash of the head and tail of the file. Never 0.
+    uint64_t computeDocumentFingerprint(FPDF_DOCUMENT document, const std::string& filePath);
+}
@@ -0,0 +1,414 @@
+#include "DocumentSidecar.hpp"
+#include "TextUtils.hpp"
+#include "fpdf_doc.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_set>
+
+namespace margelo::nitro::pdfium {
+
+    static constexpr uint32_t kSidecarMagic = 0x58444450; // "PDDX"
+    static constexpr uint32_t kSidecarVersion = 1;
+    // Pages read per hold of the document lock while rebuilding
+    static constexpr int kPagesPerStep = 256;
+    // Guards against cyclic or absurdly deep outlines in broken files
+    static constexpr int kMaxOutlineDepth = 64;
+    static constexpr size_t kMaxOutlineEntries = 100000;
+
+    struct SidecarHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+        uint64_t fileSize;
+        int64_t fileTime;
+        uint32_t pageCount;
+        uint32_t outlineCount;
+        uint32_t destCount;
+        uint32_t reserved;
+        uint64_t stringsSize;
+    };
+
+    // UTF-8 string in the string section
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct OutlineRecord {
+        StringRef title;
+        int32_t pageIndex;
+        int32_t depth;
+    };
+
+    // Sorted by name for binary search
+    struct DestRecord {
+        StringRef name;
+        int32_t pageIndex;
+        int32_t reserved;
+    };
+
+    // The header is followed by page widths, page heights, page labels, outline, named
+    // destinations and the strings, each section starting 8 byte aligned
+    struct SidecarLayout {
+        uint64_t widths;
+        uint64_t heights;
+        uint64_t labels;
+        uint64_t outline;
+        uint64_t dests;
+        uint64_t strings;
+        uint64_t total;
+    };
+
+    static uint64_t align8(uint64_t offset) {
+        return (offset + 7) & ~7ULL;
+    }
+
+    static SidecarLayout layoutOf(const SidecarHeader& header) {
+        SidecarLayout layout;
+        layout.widths = align8(sizeof(SidecarHeader));
+        layout.heights = align8(layout.widths + sizeof(float) * (uint64_t)header.pageCount);
+        layout.labels = align8(layout.heights + sizeof(float) * (uint64_t)header.pageCount);
+        layout.outline = align8(layout.labels + sizeof(StringRef) * (uint64_t)header.pageCount);
+        layout.dests = align8(layout.outline + sizeof(OutlineRecord) * (uint64_t)header.outlineCount);
+        layout.strings = align8(layout.dests + sizeof(DestRecord) * (uint64_t)header.destCount);
+        layout.total = layout.strings + header.stringsSize;
+        return layout;
+    }
+
+    // Calls `read(buffer, bytes)` the way PDFium's UTF-16 getters expect: once to size the
+    // buffer, once to fill it. The returned size includes the terminator.
+    template <typename Read>
+    static std::string readUtf16(Read read) {
+        unsigned long bytes = read(nullptr, 0);
+        if (bytes <= 2) {
+            return "";
+        }
+        std::vector<char16_t> buffer(bytes / 2 + 1, 0);
+        read(buffer.data(), bytes);
+        return utf16ToUtf8(buffer.data(), bytes / 2 - 1);
+    }
+
+    static int getDestPage(FPDF_DOCUMENT document, FPDF_DEST dest) {
+        return dest ? FPDFDest_GetDestPageIndex(document, dest) : -1;
+    }
+
+    bool readPageSize(FPDF_DOCUMENT document, int pageIndex, float& width, float& height) {
+        FS_SIZEF size;
+        if (!FPDF_GetPageSizeByIndexF(document, pageIndex, &size)) {
+            return false;
+        }
+        width = size.width;
+        height = size.height;
+        return true;
+    }
+
+    std::string readPageLabel(FPDF_DOCUMENT document, int pageIndex) {
+        return readUtf16([&](void* buffer, unsigned long length) {
+            return FPDF_GetPageLabel(document, pageIndex, buffer, length);
+        });
+    }
+
+    static void readOutlineLevel(FPDF_DOCUMENT document, FPDF_BOOKMARK parent, int depth,
+                                 std::unordered_set<FPDF_BOOKMARK>& visited, std::vector<OutlineEntry>& outline) {
+        if (depth >= kMaxOutlineDepth) {
+            return;
+        }
+        for (FPDF_BOOKMARK bookmark = FPDFBookmark_GetFirstChild(document, parent); bookmark;
+             bookmark = FPDFBookmark_GetNextSibling(document, bookmark)) {
+            if (!visited.insert(bookmark).second || outline.size() >= kMaxOutlineEntries) {
+                return;
+            }
+            FPDF_DEST dest = FPDFBookmark_GetDest(document, bookmark);
+            if (!dest) {
+                FPDF_ACTION action = FPDFBookmark_GetAction(bookmark);
+                if (action && FPDFAction_GetType(action) == PDFACTION_GOTO) {
+                    dest = FPDFAction_GetDest(document, action);
+                }
+            }
+            std::string title = readUtf16([&](void* buffer, unsigned long length) {
+                return FPDFBookmark_GetTitle(bookmark, buffer, length);
+            });
+            outline.push_back({std::move(title), getDestPage(document, dest), depth});
+            readOutlineLevel(document, bookmark, depth + 1, visited, outline);
+        }
+    }
+
+    std::vector<OutlineEntry> readOutline(FPDF_DOCUMENT document) {
+        std::vector<OutlineEntry> outline;
+        std::unordered_set<FPDF_BOOKMARK> visited;
+        readOutlineLevel(document, nullptr, 0, visited, outline);
+        return outline;
+    }
+
+    int readNamedDestPage(FPDF_DOCUMENT document, const std::string& name) {
+        return getDestPage(document, FPDF_GetNamedDestByName(document, name.c_str()));
+    }
+
+    static std::vector<NamedDestEntry> readNamedDests(FPDF_DOCUMENT document) {
+        std::vector<NamedDestEntry> dests;
+        int count = (int)FPDF_CountNamedDests(document);
+        for (int i = 0; i < count; i++) {
+            long bytes = 0;
+            FPDF_GetNamedDest(document, i, nullptr, &bytes);
+            if (bytes <= 2) {
+                continue;
+            }
+            std::vector<char16_t> buffer(bytes / 2 + 1, 0);
+            FPDF_DEST dest = FPDF_GetNamedDest(document, i, buffer.data(), &bytes);
+            if (!dest || bytes <= 2) {
+                continue;
+            }
+            dests.push_back({utf16ToUtf8(buffer.data(), bytes / 2 - 1), getDestPage(document, dest)});
+        }
+        std::sort(dests.begin(), dests.end(), [](const NamedDestEntry& a, const NamedDestEntry& b) {
+            return a.name < b.name;
+        });
+        return dests;
+    }
+
+    static bool statFile(const std::string& filePath, uint64_t& size, int64_t& time) {
+        struct stat info;
+        if (stat(filePath.c_str(), &info) != 0) {
+            return false;
+        }
+        size = info.st_size;
+        time = info.st_mtime;
+        return true;
+    }
+
+    bool DocumentSidecar::open(const std::string& directory, uint64_t fingerprint, const std::string& filePath,
+                               int pageCount, DocumentReader reader) {
+        close();
+        BuildInfo info{"", fingerprint, 0, 0, pageCount};
+        if (!statFile(filePath, info.fileSize, info.fileTime)) {
+            return false;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.pdx", (unsigned long long)fingerprint);
+        ::mkdir(directory.c_str(), 0755);
+        info.path = directory + "/" + name;
+
+        if (map(info.path, info)) {
+            return true;
+        }
+        m_stopRequested.store(false);
+        m_building.store(true);
+        m_thread = std::thread(&DocumentSidecar::build, this, std::move(info), std::move(reader));
+        return false;
+    }
+
+    void DocumentSidecar::close() {
+        m_stopRequested.store(true);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        m_building.store(false);
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (m_map) {
+            munmap(m_map, m_mapSize);
+            m_map = nullptr;
+            m_mapSize = 0;
+        }
+    }
+
+    bool DocumentSidecar::map(const std::string& path, const BuildInfo& expected) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(SidecarHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void* map = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+
+        const SidecarHeader* header = (const SidecarHeader*)map;
+        if (header->magic != kSidecarMagic || header->version != kSidecarVersion ||
+            header->fingerprint != expected.fingerprint || header->fileSize != expected.fileSize ||
+            header->fileTime != expected.fileTime || (int)header->pageCount != expected.pageCount ||
+            layoutOf(*header).total != (uint64_t)info.st_size) {
+            munmap(map, info.st_size);
+            return false;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_map = (uint8_t*)map;
+        m_mapSize = info.st_size;
+        return true;
+    }
+
+    void DocumentSidecar::build(BuildInfo info, DocumentReader reader) {
+        std::vector<float> widths(info.pageCount, 0), heights(info.pageCount, 0);
+        std::vector<std::string> labels(info.pageCount);
+        std::vector<OutlineEntry> outline;
+        std::vector<NamedDestEntry> dests;
+
+        // Pages are read in steps so rendering is not held up by a document with many pages
+        for (int first = 0; first < info.pageCount; first += kPagesPerStep) {
+            int last = std::min(first + kPagesPerStep, info.pageCount);
+            bool read = reader([&](FPDF_DOCUMENT document) {
+                for (int i = first; i < last; i++) {
+                    readPageSize(document, i, widths[i], heights[i]);
+                    labels[i] = readPageLabel(document, i);
+                }
+            });
+            if (!read || m_stopRequested.load()) {
+                m_building.store(false);
+                return;
+            }
+            std::this_thread::yield();
+        }
+        bool read = reader([&](FPDF_DOCUMENT document) {
+            outline = readOutline(document);
+            dests = readNamedDests(document);
+        });
+        if (!read || m_stopRequested.load()) {
+            m_building.store(false);
+            return;
+        }
+
+        std::string strings;
+        auto addString = [&strings](const std::string& value) {
+            StringRef ref{(uint32_t)strings.size(), (uint32_t)value.size()};
+            strings += value;
+            return ref;
+        };
+        std::vector<StringRef> labelRefs;
+        labelRefs.reserve(labels.size());
+        for (const std::string& label : labels) {
+            labelRefs.push_back(addString(label));
+        }
+        std::vector<OutlineRecord> outlineRecords;
+        outlineRecords.reserve(outline.size());
+        for (const OutlineEntry& entry : outline) {
+            outlineRecords.push_back({addString(entry.title), entry.pageIndex, entry.depth});
+        }
+        std::vector<DestRecord> destRecords;
+        destRecords.reserve(dests.size());
+        for (const NamedDestEntry& dest : dests) {
+            destRecords.push_back({addString(dest.name), dest.pageIndex, 0});
+        }
+
+        SidecarHeader header{kSidecarMagic, kSidecarVersion, info.fingerprint, info.fileSize, info.fileTime,
+                             (uint32_t)info.pageCount, (uint32_t)outlineRecords.size(),
+                             (uint32_t)destRecords.size(), 0, strings.size()};
+        SidecarLayout layout = layoutOf(header);
+        std::vector<uint8_t> file(layout.total, 0);
+        std::memcpy(file.data(), &header, sizeof(header));
+        std::memcpy(file.data() + layout.widths, widths.data(), widths.size() * sizeof(float));
+        std::memcpy(file.data() + layout.heights, heights.data(), heights.size() * sizeof(float));
+        std::memcpy(file.data() + layout.labels, labelRefs.data(), labelRefs.size() * sizeof(StringRef));
+        std::memcpy(file.data() + layout.outline, outlineRecords.data(), outlineRecords.size() * sizeof(OutlineRecord));
+        std::memcpy(file.data() + layout.dests, destRecords.data(), destRecords.size() * sizeof(DestRecord));
+        std::memcpy(file.data() + layout.strings, strings.data(), strings.size());
+
+        // Written next to the sidecar and renamed over it, so a reader never sees a partial file
+        std::string tempPath = info.path + ".tmp";
+        int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        bool written = fd >= 0 && write(fd, file.data(), file.size()) == (ssize_t)file.size();
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        if (!written || rename(tempPath.c_str(), info.path.c_str()) != 0) {
+            std::cerr << "Failed to write the document sidecar " << info.path << std::endl;
+            unlink(tempPath.c_str());
+        } else if (!m_stopRequested.load()) {
+            map(info.path, info);
+        }
+        m_building.store(false);
+    }
+
+    bool DocumentSidecar::isLoaded() const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return m_map != nullptr;
+    }
+
+    std::string DocumentSidecar::stringAt(uint32_t offset, uint32_t length) const {
+        const SidecarHeader* header = (const SidecarHeader*)m_map;
+        if ((uint64_t)offset + length > header->stringsSize) {
+            return "";
+        }
+        return std::string((const char*)m_map + layoutOf(*header).strings + offset, length);
+    }
+
+    bool DocumentSidecar::getPageSizes(std::vector<float>& widths, std::vector<float>& heights) const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (!m_map) {
+            return false;
+        }
+        const SidecarHeader* header = (const SidecarHeader*)m_map;
+        SidecarLayout layout = layoutOf(*header);
+        const float* mappedWidths = (const float*)(m_map + layout.widths);
+        const float* mappedHeights = (const float*)(m_map + layout.heights);
+        widths.assign(mappedWidths, mappedWidths + header->pageCount);
+        heights.assign(mappedHeights, mappedHeights + header->pageCount);
+        return true;
+    }
+
+    bool DocumentSidecar::getPageLabel(int pageIndex, std::string& label) const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (!m_map) {
+            return false;
+        }
+        const SidecarHeader* header = (const SidecarHeader*)m_map;
+        label.clear();
+        if (pageIndex >= 0 && pageIndex < (int)header->pageCount) {
+            const StringRef& ref = ((const StringRef*)(m_map + layoutOf(*header).labels))[pageIndex];
+            label = stringAt(ref.offset, ref.length);
+        }
+        return true;
+    }
+
+    bool DocumentSidecar::getOutline(std::vector<OutlineEntry>& outline) const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (!m_map) {
+            return false;
+        }
+        const SidecarHeader* header = (const SidecarHeader*)m_map;
+        const OutlineRecord* records = (const OutlineRecord*)(m_map + layoutOf(*header).outline);
+        outline.clear();
+        outline.reserve(header->outlineCount);
+        for (uint32_t i = 0; i < header->outlineCount; i++) {
+            outline.push_back({stringAt(records[i].title.offset, records[i].title.length),
+                               records[i].pageIndex, records[i].depth});
+        }
+        return true;
+    }
+
+    bool DocumentSidecar::getNamedDestPage(const std::string& name, int& pageIndex) const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        if (!m_map) {
+            return false;
+        }
+        const SidecarHeader* header = (const SidecarHeader*)m_map;
+        SidecarLayout layout = layoutOf(*header);
+        const DestRecord* begin = (const DestRecord*)(m_map + layout.dests);
+        const DestRecord* end = begin + header->destCount;
+        const char* strings = (const char*)m_map + layout.strings;
+        auto nameOf = [&](const DestRecord& record) {
+            if ((uint64_t)record.name.offset + record.name.length > header->stringsSize) {
+                return std::string_view();
+            }
+            return std::string_view(strings + record.name.offset, record.name.length);
+        };
+        const DestRecord* found = std::lower_bound(begin, end, name, [&](const DestRecord& record, const std::string& key) {
+            return nameOf(record) < std::string_view(key);
+        });
+        pageIndex = found != end && nameOf(*found) == name ? found->pageIndex : -1;
+        return true;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fpdfview.h"
+
+namespace margelo::nitro::pdfium {
+
+    // An outline (bookmark) entry, flattened in document order. Children follow their parent
+    // with a depth one higher.
+    struct OutlineEntry {
+        std::string title;
+        int pageIndex; // -1 if the entry has no destination in the document
+        int depth;
+    };
+
+    struct NamedDestEntry {
+        std::string name;
+        int pageIndex;
+    };
+
+    // Readers for the data kept in the sidecar. The caller holds the document lock. They are
+    // also used directly while no sidecar is loaded.
+    bool readPageSize(FPDF_DOCUMENT document, int pageIndex, float& width, float& height);
+    std::string readPageLabel(FPDF_DOCUMENT document, int pageIndex);
+    std::vector<OutlineEntry> readOutline(FPDF_DOCUMENT document);
+    int readNamedDestPage(FPDF_DOCUMENT document, const std::string& name);
+
+    // Document-level data that is slow to collect for large files (page sizes, page labels,
+    // outline and named destinations), persisted in a binary file per document fingerprint.
+    // On open a current sidecar is memory-mapped and served without touching the document.
+    // A missing or outdated one (other version, file size or modification time) is rebuilt on
+    // a background thread, and mapped once written.
+    class DocumentSidecar {
+        public:
+            // Runs `read` on the document while holding the document lock. Returns false if the
+            // document the sidecar was opened for has been closed.
+            using DocumentReader = std::function<bool(const std::function<void(FPDF_DOCUMENT)>& read)>;
+
+            DocumentSidecar() = default;
+            DocumentSidecar(const DocumentSidecar&) = delete;
+            DocumentSidecar& operator=(const DocumentSidecar&) = delete;
+            ~DocumentSidecar() { close(); }
+
+            // Maps the sidecar of the document in `directory`, or starts rebuilding it. Returns
+            // true if it was mapped right away.
+            bool open(const std::string& directory, uint64_t fingerprint, const std::string& filePath,
+                      int pageCount, DocumentReader reader);
+            // Stops a running rebuild and unmaps the sidecar. Must not be called while holding
+            // the document lock, the rebuild may be waiting for it.
+            void close();
+
+            bool isLoaded() const;
+            bool isBuilding() const { return m_building.load(); }
+
+            // The accessors return false while no sidecar is loaded
+            bool getPageSizes(std::vector<float>& widths, std::vector<float>& heights) const;
+            bool getPageLabel(int pageIndex, std::string& label) const;
+            bool getOutline(std::vector<OutlineEntry>& outline) const;
+            bool getNamedDestPage(const std::string& name, int& pageIndex) const;
+
+        private:
+            struct BuildInfo {
+                std::string path;
+                uint64_t fingerprint;
+                uint64_t fileSize;
+                int64_t fileTime;
+                int pageCount;
+            };
+
+            bool map(const std::string& path, const BuildInfo& expected);
+            void build(BuildInfo info, DocumentReader reader);
+            std::string stringAt(uint32_t offset, uint32_t length) const;
+
+            mutable std::shared_mutex m_mutex; // Guards the mapping
+            uint8_t* m_map = nullptr;
+            size_t m_mapSize = 0;
+
+            std::thread m_thread;
+            std::atomic<bool> m_stopRequested{false};
+            std::atomic<bool> m_building{false};
+    };
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::pdfium {
+
+    // FNV-1a, for cache keys, fingerprints and checksums. Fast and well spread, but not meant
+    // to resist inputs crafted to collide.
+    inline constexpr uint64_t kHashSeed = 14695981039346656037ULL;
+
+    inline uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+        const uint8_t* bytes = (const uint8_t*)data;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // Hashes the bytes of a plain value such as a number
+    template<typename T>
+    inline uint64_t hashValue(uint64_t hash, const T& value) {
+        return hashBytes(hash, &value, sizeof(value));
+    }
+}
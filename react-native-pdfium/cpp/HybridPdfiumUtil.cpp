@@ -1,7 +1,23 @@
 #include "HybridPdfiumUtil.hpp"
+#include "BufferUtils.hpp"
+#include "DocumentFingerprint.hpp"
+#include "Hashing.hpp"
+#include "TextUtils.hpp"
+#include "TileFormats.hpp"
+#include "fpdf_edit.h"
+#include "fpdf_progressive.h"
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
 
 namespace margelo::nitro::pdfium {
 
+    // Whether a number from JS is finite and within 0...INT_MAX, so casting it is well defined
+    static bool fitsInt(double value) {
+        return std::isfinite(value) && value >= 0 && value <= INT_MAX;
+    }
+
     void HybridPdfiumUtil::cleanupDistantPages(int currentPageIndex) {
         std::vector<int> keysToRemove;
         
@@ -16,6 +32,10 @@ namespace margelo::nitro::pdfium {
         // Remove the collected keys and free their associated resources
         for (int key : keysToRemove) {
             FPDF_PAGE pageToClose = m_pageCache[key];
+            m_textPageCache.evict(key);
+            m_pageElementCache.erase(key);
+            m_pageOccupancyCache.erase(key);
+            m_regionRenderer.evictPage(key);
             if (pageToClose) {
                 FPDF_ClosePage(pageToClose);
             }
@@ -24,6 +44,9 @@ namespace margelo::nitro::pdfium {
     }
 
     FPDF_PAGE HybridPdfiumUtil::getPage(FPDF_DOCUMENT m_pdfDoc, int pageIndex) {
+        // Reading position drives which pages get text indexed first
+        m_textIndex.setFocusPage(pageIndex);
+
         // Check if the page is already cached
         auto it =  m_pageCache.find(pageIndex);
         if (it != m_pageCache.end()) {
@@ -40,7 +63,49 @@ namespace margelo::nitro::pdfium {
         return page;
     }
 
+    TextPageEntry* HybridPdfiumUtil::getTextPage(int pageIndex) {
+        if (!m_pdfDoc) {
+            std::cerr << "No PDF document was loaded" << std::endl;
+            return nullptr;
+        }
+        FPDF_PAGE page = getPage(m_pdfDoc, pageIndex);
+        if (!page) {
+            std::cerr << "Failed to load the page " << pageIndex << " for document." << std::endl;
+            return nullptr;
+        }
+        TextPageEntry* entry = m_textPageCache.get(page, pageIndex);
+        if (!entry) {
+            std::cerr << "Failed to load the text of page " << pageIndex << "." << std::endl;
+        }
+        return entry;
+    }
+
+    bool HybridPdfiumUtil::visitPage(int pageIndex, const std::function<void(FPDF_PAGE)>& visit) {
+        // Used by background workers. Pages are loaded directly instead of going through the
+        // page cache so that a worker walking the document does not evict the pages the user
+        // is looking at.
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        if (!m_pdfDoc) {
+            return false;
+        }
+        auto cached = m_pageCache.find(pageIndex);
+        FPDF_PAGE page = cached != m_pageCache.end() ? cached->second : FPDF_LoadPage(m_pdfDoc, pageIndex);
+        if (!page) {
+            return false;
+        }
+        visit(page);
+        if (cached == m_pageCache.end()) {
+            FPDF_ClosePage(page);
+        }
+        return true;
+    }
+
 void HybridPdfiumUtil::clearPageCache() {
+        // Text pages refer to their pages and have to be closed first
+        m_textPageCache.clear();
+        m_pageElementCache.clear();
+        m_pageOccupancyCache.clear();
+        m_regionRenderer.clear();
         for (auto& entry : m_pageCache) {
             FPDF_ClosePage(entry.second);
         }
@@ -53,7 +118,8 @@ void HybridPdfiumUtil::clearPageCache() {
     }
 
     double HybridPdfiumUtil::getPageCount() {
-        
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+
         if (m_pdfDoc == nullptr) {
             std::cerr << "Failed to load the PDF document." << std::endl;
             return 0;
@@ -69,105 +135,550 @@ void HybridPdfiumUtil::clearPageCache() {
         // Vector to store dimensions
         // We do not have to explicitly free memory as std::vector is returned by value
         std::vector<std::tuple<double, double, double>> pageDimensions;
-        
+        std::vector<float> widths, heights;
+
+        // Served from the sidecar without taking the document lock when it is loaded
+        if (!m_sidecar.getPageSizes(widths, heights)) {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+
+            if (m_pdfDoc == nullptr) {
+                std::cerr << "No PDF document was loaded" << std::endl;
+                return pageDimensions;
+            }
+
+            // Sizes are read from the page dictionaries, without loading the pages
+            int pageCount = FPDF_GetPageCount(m_pdfDoc);
+            widths.resize(pageCount);
+            heights.resize(pageCount);
+            for (int i = 0; i < pageCount; ++i) {
+                if (!readPageSize(m_pdfDoc, i, widths[i], heights[i])) {
+                    std::cerr << "Failed to load page " << i << "." << std::endl;
+                }
+            }
+        }
+
+        double aggregatedHeight = 0;
+        pageDimensions.reserve(widths.size());
+        for (size_t i = 0; i < widths.size(); ++i) {
+            aggregatedHeight += heights[i];
+            pageDimensions.emplace_back(widths[i], heights[i], aggregatedHeight);
+        }
+
+        return pageDimensions;
+    }
+
+    bool HybridPdfiumUtil::ensurePageGeometry() {
         if (m_pdfDoc == nullptr) {
-            std::cerr << "No PDF document was loaded" << std::endl;
-            return pageDimensions;
+            return false;
         }
-        
-        // Get the total number of pages
         int pageCount = FPDF_GetPageCount(m_pdfDoc);
+        if (m_pageGeometry.getPageCount() == pageCount) {
+            return true;
+        }
+        std::vector<float> widths, heights;
+        if (!m_sidecar.getPageSizes(widths, heights) || (int)widths.size() != pageCount) {
+            widths.assign(pageCount, 0);
+            heights.assign(pageCount, 0);
+            for (int i = 0; i < pageCount; i++) {
+                readPageSize(m_pdfDoc, i, widths[i], heights[i]);
+            }
+        }
+        m_pageGeometry.reset(std::move(widths), std::move(heights));
+        return true;
+    }
 
-        double aggregatedHeight = 0;
-        // Iterate over all pages
-        for (int i = 0; i < pageCount; ++i) {
-            // Load the page
-            FPDF_PAGE page = getPage(m_pdfDoc, i);
-            if (!page) {
-                std::cerr << "Failed to load page " << i << "." << std::endl;
-                continue;
+    void HybridPdfiumUtil::setViewportOptions(const ViewportOptions& options) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        m_viewportOptions = options;
+        m_pageGeometry.setLayout(options.layoutMode, options.pageGap, options.spreadGap);
+    }
+
+    std::vector<double> HybridPdfiumUtil::getLayoutSize() {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        if (!ensurePageGeometry()) {
+            return {0, 0};
+        }
+        return {m_pageGeometry.getContentWidth(), m_pageGeometry.getContentHeight()};
+    }
+
+    double HybridPdfiumUtil::getFitWidthScale(double viewportWidth) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        if (!ensurePageGeometry()) {
+            return 1;
+        }
+        return m_pageGeometry.getFitWidthScale(viewportWidth);
+    }
+
+    std::vector<double> HybridPdfiumUtil::getVisiblePages(double offsetX, double offsetY, double scale, double width, double height) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        int firstPage, lastPage;
+        if (!ensurePageGeometry() || scale <= 0 ||
+            !m_pageGeometry.getPagesInRect(offsetX / scale, offsetY / scale, (offsetX + width) / scale,
+                                           (offsetY + height) / scale, firstPage, lastPage)) {
+            return {};
+        }
+        // The bands found are along the scroll direction, pages may still miss across it
+        double left = offsetX / scale, top = offsetY / scale;
+        double right = (offsetX + width) / scale, bottom = (offsetY + height) / scale;
+        std::vector<double> pages;
+        for (int page = firstPage; page <= lastPage; page++) {
+            double pageLeft = m_pageGeometry.getPageLeft(page);
+            double pageTop = m_pageGeometry.getPageTop(page);
+            if (pageLeft < right && pageLeft + m_pageGeometry.getPageWidth(page) > left &&
+                pageTop < bottom && pageTop + m_pageGeometry.getPageHeight(page) > top) {
+                pages.push_back(page);
             }
+        }
+        return pages;
+    }
 
-            // Get the width and height of the page
-            double width = FPDF_GetPageWidth(page);
-            double height = FPDF_GetPageHeight(page);
-            aggregatedHeight += height;
-            // Store the dimensions
-            pageDimensions.emplace_back(width, height, aggregatedHeight);
+    std::shared_ptr<ArrayBuffer> HybridPdfiumUtil::getPageGeometry(double firstPage, double count) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        if (!ensurePageGeometry()) {
+            return allocateBuffer(0);
         }
+        int pageCount = m_pageGeometry.getPageCount();
+        int first = std::clamp((int)firstPage, 0, pageCount);
+        int n = std::clamp((int)count, 0, pageCount - first);
 
-        return pageDimensions;
+        // One lane of n doubles per field, written straight into the buffer handed to JS
+        std::shared_ptr<ArrayBuffer> buf = allocateBuffer((size_t)n * kPageGeometryLanes * sizeof(double));
+        double* widths = reinterpret_cast<double*>(buf->data());
+        double* heights = widths + n;
+        double* lefts = heights + n;
+        double* tops = lefts + n;
+        double* rotations = tops + n;
+        for (int i = 0; i < n; i++) {
+            int page = first + i;
+            widths[i] = m_pageGeometry.getPageWidth(page);
+            heights[i] = m_pageGeometry.getPageHeight(page);
+            lefts[i] = m_pageGeometry.getPageLeft(page);
+            tops[i] = m_pageGeometry.getPageTop(page);
+            // Only known for loaded pages, loading the others would parse their content
+            auto cached = m_pageCache.find(page);
+            rotations[i] = cached != m_pageCache.end() ? FPDFPage_GetRotation(cached->second) : -1;
+        }
+        return buf;
+    }
+
+    std::vector<double> HybridPdfiumUtil::getPageRange(double start, double end) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        int firstPage, lastPage;
+        if (!ensurePageGeometry() || !m_pageGeometry.getPagesInRect(start, start, end, end, firstPage, lastPage)) {
+            return {};
+        }
+        return {(double)firstPage, (double)lastPage};
+    }
+
+    std::vector<ViewportTile> HybridPdfiumUtil::renderViewport(double offsetX, double offsetY, double scale, double width, double height) {
+        // Where a tile goes in the viewport, in screen points
+        struct Placement {
+            TileRequest request;
+            double x;
+            double y;
+            double width;
+            double height;
+        };
+        std::vector<Placement> placements;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+            if (!ensurePageGeometry() || scale <= 0) {
+                return {};
+            }
+            const ViewportOptions& options = m_viewportOptions;
+            double pixelRatio = options.pixelRatio > 0 ? options.pixelRatio : 1;
+            double renderScale = scale * pixelRatio;
+            int tilePixels = std::max((int)(options.tileSize * pixelRatio), 1);
+
+            int firstPage, lastPage;
+            if (!m_pageGeometry.getPagesInRect(offsetX / scale, offsetY / scale, (offsetX + width) / scale,
+                                               (offsetY + height) / scale, firstPage, lastPage)) {
+                return {};
+            }
+            for (int page = firstPage; page <= lastPage; page++) {
+                double pageLeft = m_pageGeometry.getPageLeft(page) * scale;
+                double pageTop = m_pageGeometry.getPageTop(page) * scale;
+                double pageWidth = m_pageGeometry.getPageWidth(page) * scale;
+                double pageHeight = m_pageGeometry.getPageHeight(page) * scale;
+                int pageWidthPixels = (int)std::ceil(pageWidth * pixelRatio);
+                int pageHeightPixels = (int)std::ceil(pageHeight * pixelRatio);
+
+                // Visible part of the page, in pixels of the page rendered at renderScale
+                double left = std::max(offsetX - pageLeft, 0.0) * pixelRatio;
+                double right = std::min(offsetX + width - pageLeft, pageWidth) * pixelRatio;
+                double top = std::max(offsetY - pageTop, 0.0) * pixelRatio;
+                double bottom = std::min(offsetY + height - pageTop, pageHeight) * pixelRatio;
+                if (right <= left || bottom <= top) {
+                    continue;
+                }
+
+                int lastRow = (int)std::ceil(bottom / tilePixels) - 1;
+                int lastColumn = (int)std::ceil(right / tilePixels) - 1;
+                for (int row = (int)(top / tilePixels); row <= lastRow; row++) {
+                    for (int column = (int)(left / tilePixels); column <= lastColumn; column++) {
+                        // Tiles on the right and bottom edges are cut to the page
+                        int tileWidth = std::min(tilePixels, pageWidthPixels - column * tilePixels);
+                        int tileHeight = std::min(tilePixels, pageHeightPixels - row * tilePixels);
+                        if (tileWidth <= 0 || tileHeight <= 0) {
+                            continue;
+                        }
+                        placements.push_back({
+                            TileRequest(page, -row * tilePixels, -column * tilePixels, tileWidth, tileHeight, renderScale,
+                                        options.pixelFormat, options.colorMode, std::nullopt, std::nullopt),
+                            pageLeft + column * tilePixels / pixelRatio - offsetX,
+                            pageTop + row * tilePixels / pixelRatio - offsetY,
+                            tileWidth / pixelRatio,
+                            tileHeight / pixelRatio
+                        });
+                    }
+                }
+            }
+        }
+
+        // Cached tiles are served without the document lock
+        std::vector<ViewportTile> tiles;
+        tiles.reserve(placements.size());
+        for (const Placement& placement : placements) {
+            tiles.emplace_back(renderTile(placement.request), placement.request.pageNumber,
+                               placement.x, placement.y, placement.width, placement.height);
+        }
+        return tiles;
+    }
+
+    void HybridPdfiumUtil::setSidecarDirectory(const std::string& directory) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        m_sidecarDirectory = directory;
+    }
+
+    std::vector<OutlineItem> HybridPdfiumUtil::getOutline() {
+        std::vector<OutlineEntry> outline;
+        if (!m_sidecar.getOutline(outline)) {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+            if (m_pdfDoc == nullptr) {
+                std::cerr << "No PDF document was loaded" << std::endl;
+                return {};
+            }
+            outline = readOutline(m_pdfDoc);
+        }
+
+        std::vector<OutlineItem> items;
+        items.reserve(outline.size());
+        for (OutlineEntry& entry : outline) {
+            items.emplace_back(std::move(entry.title), entry.pageIndex, entry.depth);
+        }
+        return items;
+    }
+
+    std::string HybridPdfiumUtil::getPageLabel(double pageNumber) {
+        std::string label;
+        if (!m_sidecar.getPageLabel((int)pageNumber, label)) {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+            if (m_pdfDoc == nullptr) {
+                std::cerr << "No PDF document was loaded" << std::endl;
+                return "";
+            }
+            label = readPageLabel(m_pdfDoc, (int)pageNumber);
+        }
+        return label;
+    }
+
+    double HybridPdfiumUtil::getNamedDestinationPage(const std::string& name) {
+        int pageIndex = -1;
+        if (!m_sidecar.getNamedDestPage(name, pageIndex)) {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+            if (m_pdfDoc == nullptr) {
+                std::cerr << "No PDF document was loaded" << std::endl;
+                return -1;
+            }
+            pageIndex = readNamedDestPage(m_pdfDoc, name);
+        }
+        return pageIndex;
     }
 
 
     void HybridPdfiumUtil::openPdf(const std::string& filePath) {
+        cancelOpen();
+        loadDocument(filePath);
+    }
+
+    bool HybridPdfiumUtil::loadDocument(const std::string& filePath) {
         std::cout << "Openning pdf " << filePath << std::endl;
+        m_textIndex.stop();
+        m_sidecar.close();
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
         if (m_pdfDoc != nullptr) {
-            closePdf();
+            closeDocument();
         }
+        auto start = std::chrono::steady_clock::now();
         const char* pdf_path = filePath.c_str();
         m_pdfDoc = FPDF_LoadDocument(pdf_path, nullptr);
+        {
+            std::lock_guard<std::mutex> timingsLock(m_openTimingsMutex);
+            m_openTimings = {};
+            m_openTimings.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (m_pdfDoc) {
+            m_documentFingerprint = computeDocumentFingerprint(m_pdfDoc, filePath);
+        }
+        if (m_pdfDoc && !m_sidecarDirectory.empty()) {
+            int documentId = m_documentId;
+            m_sidecar.open(m_sidecarDirectory, m_documentFingerprint, filePath, FPDF_GetPageCount(m_pdfDoc),
+                           [this, documentId](const std::function<void(FPDF_DOCUMENT)>& read) {
+                std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+                if (documentId != m_documentId || !m_pdfDoc) {
+                    return false;
+                }
+                read(m_pdfDoc);
+                return true;
+            });
+        }
+        return m_pdfDoc != nullptr;
+    }
+
+    void HybridPdfiumUtil::openPdfAsync(const std::string& filePath, const std::optional<TileRequest>& initialTile,
+                                        const std::function<void(double, const std::optional<RenderedTile>&)>& onOpened,
+                                        const std::function<void(double, const std::vector<double>&, bool)>& onPageSizes) {
+        cancelOpen();
+        m_openCancelled.store(false);
+        m_openThread = std::thread([this, filePath, initialTile, onOpened, onPageSizes]() {
+            auto start = std::chrono::steady_clock::now();
+            auto elapsedMs = [start]() {
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            };
+
+            if (!loadDocument(filePath)) {
+                std::cerr << "Failed to open the PDF document " << filePath << std::endl;
+                onOpened(0, std::nullopt);
+                return;
+            }
+            int pageCount = 0;
+            int documentId = 0;
+            {
+                std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+                documentId = m_documentId;
+                pageCount = m_pdfDoc ? FPDF_GetPageCount(m_pdfDoc) : 0;
+                // Parsed now so the first render does not pay for it
+                if (pageCount > 0) {
+                    getPage(m_pdfDoc, initialTile ? (int)initialTile->pageNumber : 0);
+                }
+            }
+            double firstPageMs = elapsedMs();
+
+            std::optional<RenderedTile> firstTile;
+            if (initialTile && !m_openCancelled.load()) {
+                firstTile = renderTile(*initialTile);
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_openTimingsMutex);
+                m_openTimings.firstPageMs = firstPageMs;
+                m_openTimings.firstTileMs = elapsedMs();
+            }
+            if (m_openCancelled.load()) {
+                return;
+            }
+            onOpened(pageCount, firstTile);
+
+            // A loaded sidecar has every size at hand, otherwise they are read in batches so
+            // rendering can interleave
+            std::vector<float> widths, heights;
+            if (m_sidecar.getPageSizes(widths, heights)) {
+                std::vector<double> sizes;
+                sizes.reserve(widths.size() * 2);
+                for (size_t i = 0; i < widths.size(); i++) {
+                    sizes.push_back(widths[i]);
+                    sizes.push_back(heights[i]);
+                }
+                onPageSizes(0, sizes, true);
+            } else {
+                for (int first = 0; first < pageCount || first == 0; first += kPageSizeBatch) {
+                    int last = std::min(first + kPageSizeBatch, pageCount);
+                    std::vector<double> sizes;
+                    sizes.reserve((last - first) * 2);
+                    {
+                        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+                        if (m_openCancelled.load() || documentId != m_documentId || !m_pdfDoc) {
+                            return;
+                        }
+                        for (int i = first; i < last; i++) {
+                            float width = 0, height = 0;
+                            readPageSize(m_pdfDoc, i, width, height);
+                            sizes.push_back(width);
+                            sizes.push_back(height);
+                        }
+                    }
+                    onPageSizes(first, sizes, last >= pageCount);
+                }
+            }
+            std::lock_guard<std::mutex> lock(m_openTimingsMutex);
+            m_openTimings.geometryMs = elapsedMs();
+        });
+    }
+
+    void HybridPdfiumUtil::cancelOpen() {
+        m_openCancelled.store(true);
+        if (m_openThread.joinable()) {
+            m_openThread.join();
+        }
+    }
+
+    OpenTimings HybridPdfiumUtil::getOpenTimings() {
+        std::lock_guard<std::mutex> lock(m_openTimingsMutex);
+        return OpenTimings(m_openTimings.loadMs, m_openTimings.firstPageMs, m_openTimings.firstTileMs, m_openTimings.geometryMs);
     }
 
     void HybridPdfiumUtil::closePdf() {
+        cancelOpen();
+        closeDocument();
+    }
+
+    void HybridPdfiumUtil::closeDocument() {
         std::cout << "Closing pdf " << std::endl;
+        // The indexer takes the document lock for every page, so it has to be stopped first
+        m_textIndex.stop();
+        m_textSearch.cancel();
+        m_tileUpgrader.cancel();
+        m_renderScheduler.cancelAll();
+        m_sidecar.close();
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
         clearPageCache();
+        m_grayscalePages.clear();
+        m_pageGeometry.clear();
+        if (m_atlas) {
+            m_atlas->clear();
+        }
+        m_tileCache.clear();
+        m_documentId++;
+        m_documentFingerprint = 0;
         if (m_pdfDoc!= nullptr) {
             FPDF_CloseDocument(m_pdfDoc);
+            m_pdfDoc = nullptr;
         }
     }
 
-    std::shared_ptr<ArrayBuffer> HybridPdfiumUtil::getTile(double pageNumber, double row, double column, double displayWidth, double tileWidthD, double tileHeightD, double scale) {
-        
+    // Narrows the clip of a tile to the page content under it. Returns false if the tile covers
+    // no content at all, in which case rendering can be skipped.
+    static bool getContentClip(const PageOccupancy& occupancy, int tileWidth, int tileHeight,
+                               double row, double column, double scale, FS_RECTF& clip) {
+        PageRect tileRect{-column / scale, -row / scale, (tileWidth - column) / scale, (tileHeight - row) / scale};
+        PageRect content;
+        if (!occupancy.contentIn(tileRect, content)) {
+            return false;
+        }
+        // Keep a pixel of slack for antialiasing at the content edges
+        clip.left = (float)std::clamp(std::floor(content.left * scale + column) - 1, 0.0, (double)tileWidth);
+        clip.top = (float)std::clamp(std::floor(content.top * scale + row) - 1, 0.0, (double)tileHeight);
+        clip.right = (float)std::clamp(std::ceil(content.right * scale + column) + 1, 0.0, (double)tileWidth);
+        clip.bottom = (float)std::clamp(std::ceil(content.bottom * scale + row) + 1, 0.0, (double)tileHeight);
+        return true;
+    }
+
+    void HybridPdfiumUtil::renderPageClip(FPDF_BITMAP bitmap, FPDF_PAGE page, int pageIndex,
+                                          const FS_MATRIX& matrix, const FS_RECTF& clip, int flags) {
+        if (m_largePageMode && m_regionRenderer.render(m_pdfDoc, page, pageIndex, bitmap, matrix, clip, flags)) {
+            return;
+        }
+        FPDF_RenderPageBitmapWithMatrix(bitmap, page, &matrix, &clip, flags);
+    }
+
+    void HybridPdfiumUtil::setLargePageMode(bool enabled) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        m_largePageMode = enabled;
+        if (!enabled) {
+            m_regionRenderer.clear();
+        }
+    }
+
+    const PageOccupancy& HybridPdfiumUtil::getOccupancy(FPDF_PAGE page, int pageIndex) {
+        auto it = m_pageOccupancyCache.find(pageIndex);
+        if (it == m_pageOccupancyCache.end()) {
+            it = m_pageOccupancyCache.emplace(pageIndex, std::make_unique<PageOccupancy>(page)).first;
+        }
+        return *it->second;
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridPdfiumUtil::getTile(double pageNumber, double row, double column, double displayWidth, double tileWidthD, double tileHeightD, double scale, PixelFormat pixelFormat) {
         
+        TileFormatSpec format = getTileFormatSpec(pixelFormat);
         int tileWidth = (int)tileWidthD;
         int tileHeight = (int)tileHeightD;
-        size_t len = tileWidth * tileHeight * 4; // Initialize the length. 4 bytes are for RGBA chanels for each pixel
+        size_t len = tileWidth * tileHeight * format.bytesPerPixel; // Initialize the length. 4 bytes are for the color chanels of each pixel
         uint8_t* stream = new uint8_t[len]; // Allocate internal memory
         std::shared_ptr<ArrayBuffer> buf = ArrayBuffer::wrap(stream, len, [=]() {
             // This will clean up when the reference count is 0. Which means when the JS thread runs the GC cycle
             delete[] stream; // Cleanup lambda
         });
         
-        
+        drawTile(buf->data(), tileWidth * format.bytesPerPixel, (int)pageNumber, row, column, tileWidth, tileHeight, scale, format);
+        return buf;
+    }
+
+    bool HybridPdfiumUtil::getTileInto(const std::shared_ptr<ArrayBuffer>& target, double offset, double rowBytes,
+                                       double pageNumber, double row, double column, double tileWidthD, double tileHeightD,
+                                       double scale, PixelFormat pixelFormat) {
+        TileFormatSpec format = getTileFormatSpec(pixelFormat);
+        // Checked before casting, a negative, NaN or huge double does not convert
+        if (!target || !fitsInt(offset) || !fitsInt(rowBytes) || !fitsInt(tileWidthD) || !fitsInt(tileHeightD)) {
+            std::cerr << "Invalid target buffer layout for a tile." << std::endl;
+            return false;
+        }
+        int tileWidth = (int)tileWidthD;
+        int tileHeight = (int)tileHeightD;
+        size_t start = (size_t)offset;
+        size_t stride = (size_t)rowBytes;
+        size_t size = target->size();
+        size_t pixelBytes = (size_t)tileWidth * format.bytesPerPixel;
+        // PDFium wants 4 byte aligned rows, and the last row only needs its pixels to fit. Each step
+        // is checked against what is left of the buffer, so the extent cannot wrap around.
+        if (tileWidth <= 0 || tileHeight <= 0 || start % 4 != 0 || stride % 4 != 0 || stride < pixelBytes ||
+            start > size || pixelBytes > size - start ||
+            (size_t)(tileHeight - 1) > (size - start - pixelBytes) / stride) {
+            std::cerr << "Invalid target buffer for a " << tileWidth << "x" << tileHeight << " tile." << std::endl;
+            return false;
+        }
+        return drawTile(target->data() + start, (int)stride, (int)pageNumber, row, column, tileWidth, tileHeight, scale, format);
+    }
+
+    bool HybridPdfiumUtil::drawTile(uint8_t* buffer, int stride, int pageNumber, double row, double column,
+                                    int tileWidth, int tileHeight, double scale, const TileFormatSpec& format) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
         if (!m_pdfDoc) {
             std::cerr << "Failed to load the PDF document." << std::endl;
-            return buf;
+            return false;
         }
         
         
-        FPDF_PAGE page = getPage(m_pdfDoc, (int)pageNumber);
+        FPDF_PAGE page = getPage(m_pdfDoc, pageNumber);
         if (!page) {
             std::cerr << "Failed to load the page " << pageNumber << " for document." << std::endl;
-            return buf;
+            return false;
         }
         
-        double width = FPDF_GetPageWidth(page);
-        double height = FPDF_GetPageHeight(page);
-        int stride = tileWidth * 4;
-        FPDF_BITMAP bitmapHandle = FPDFBitmap_CreateEx(tileWidth, tileHeight, FPDFBitmap_BGRA, buf->data(), stride);
+        FPDF_BITMAP bitmapHandle = FPDFBitmap_CreateEx(tileWidth, tileHeight, format.bitmapFormat, buffer, stride);
                     
         if (!bitmapHandle) {
             std::cerr << "Failed to load the bitmap handle for document." << std::endl;
-            return buf;
+            return false;
         }
                     
         FPDFBitmap_FillRect(bitmapHandle, 0, 0, tileWidth, tileHeight, 0xffffffff);
+
+        // Tiles over empty parts of the page stay blank, the others only rasterize their content
+        FS_RECTF clip;
+        if (!getContentClip(getOccupancy(page, pageNumber), tileWidth, tileHeight, row, column, scale, clip)) {
+            FPDFBitmap_Destroy(bitmapHandle);
+            return true;
+        }
         
         float xScale = scale;//  * displayWidth / width;
         float yScale = scale;//  * displayWidth / width;
         float xTranslate = (float)column;
         float yTranslate = (float)row;
-        std::thread::id this_id = std::this_thread::get_id();
-        //std::cout << "[Thread " << this_id << "] Page " << pageNumber << " matric scale "
-        //        << scale << " xTranslate " << xTranslate << " yTranslate " << yTranslate << std::endl;
         FS_MATRIX matrix = {xScale, 0.0, 0.0, yScale, xTranslate, yTranslate}; // Flipped Y-axis.
-        FS_RECTF clip = {0, 0, (float)tileWidthD, (float)tileHeightD};
 
-        FPDF_RenderPageBitmapWithMatrix(bitmapHandle, page, &matrix, &clip, 0);
+        renderPageClip(bitmapHandle, page, pageNumber, matrix, clip, format.renderFlags);
         
         FPDFBitmap_Destroy(bitmapHandle);
-        return buf;
+        return true;
     }
 
     std::shared_ptr<ArrayBuffer> HybridPdfiumUtil::getTileBgr565(double pageNumber, double row, double column, double displayWidth, double tileWidthD, double tileHeightD, double scale) {
@@ -183,6 +694,7 @@ void HybridPdfiumUtil::clearPageCache() {
         });
         
         
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
         if (!m_pdfDoc) {
             std::cerr << "Failed to load the PDF document." << std::endl;
             return buf;
@@ -249,4 +761,636 @@ void HybridPdfiumUtil::clearPageCache() {
         
         return buf;
     }
+
+    // Rasterizes the page region of a tile into `buffer`. Row and column are the pixel offsets
+    // of the tile within the page rendered at `scale`.
+    bool HybridPdfiumUtil::renderTileBitmap(FPDF_PAGE page, int pageIndex, int bitmapFormat, uint8_t* buffer, int stride,
+                                            int tileWidth, int tileHeight, double row, double column, double scale,
+                                            const FS_RECTF& clip, int flags, const std::optional<ColorScheme>& colorScheme) {
+        FPDF_BITMAP bitmapHandle = FPDFBitmap_CreateEx(tileWidth, tileHeight, bitmapFormat, buffer, stride);
+        if (!bitmapHandle) {
+            std::cerr << "Failed to load the bitmap handle for document." << std::endl;
+            return false;
+        }
+
+        if (colorScheme) {
+            // The color scheme renderer has no matrix, it places the page by its pixel origin and size
+            FPDFBitmap_FillRect(bitmapHandle, 0, 0, tileWidth, tileHeight,
+                                toFormatByteOrder((uint32_t)colorScheme->backgroundColor, flags));
+            FPDF_COLORSCHEME scheme = {
+                (FPDF_DWORD)colorScheme->pathFillColor, (FPDF_DWORD)colorScheme->pathStrokeColor,
+                (FPDF_DWORD)colorScheme->textFillColor, (FPDF_DWORD)colorScheme->textStrokeColor
+            };
+            int status = FPDF_RenderPageBitmapWithColorScheme_Start(bitmapHandle, page, (int)std::round(column), (int)std::round(row),
+                                                                    (int)std::round(FPDF_GetPageWidthF(page) * scale),
+                                                                    (int)std::round(FPDF_GetPageHeightF(page) * scale),
+                                                                    0, flags, &scheme, nullptr);
+            while (status == FPDF_RENDER_TOBECONTINUED) {
+                status = FPDF_RenderPage_Continue(page, nullptr);
+            }
+            FPDF_RenderPage_Close(page);
+        } else {
+            FPDFBitmap_FillRect(bitmapHandle, 0, 0, tileWidth, tileHeight, 0xffffffff);
+            FS_MATRIX matrix = {(float)scale, 0.0, 0.0, (float)scale, (float)column, (float)row};
+            renderPageClip(bitmapHandle, page, pageIndex, matrix, clip, flags);
+        }
+
+        FPDFBitmap_Destroy(bitmapHandle);
+        return true;
+    }
+
+    static TileColorType toColorType(PixelFormat pixelFormat) {
+        switch (pixelFormat) {
+            case PixelFormat::RGBA: return TileColorType::RGBA8888;
+            case PixelFormat::BGRX: return TileColorType::BGRX8888;
+            case PixelFormat::RGBX: return TileColorType::RGBX8888;
+            case PixelFormat::BGRA:
+            default: return TileColorType::BGRA8888;
+        }
+    }
+
+    static RenderedTile toRenderedTile(const Palette4Tile& packed, int tileWidth, int tileHeight) {
+        std::shared_ptr<ArrayBuffer> pixels = allocateBuffer(packed.pixels.size());
+        std::copy(packed.pixels.begin(), packed.pixels.end(), pixels->data());
+        std::shared_ptr<ArrayBuffer> palette = allocateBuffer(kPaletteSize * 4);
+        std::memcpy(palette->data(), packed.palette.data(), kPaletteSize * 4);
+        return RenderedTile(pixels, tileWidth, tileHeight, packed.rowBytes, TileColorType::PALETTE4, palette, std::nullopt, TileQuality::FULL);
+    }
+
+    bool HybridPdfiumUtil::isGrayscale(FPDF_PAGE page, int pageIndex) {
+        auto it = m_grayscalePages.find(pageIndex);
+        if (it != m_grayscalePages.end()) {
+            return it->second;
+        }
+        bool grayscale = isGrayscalePage(page);
+        m_grayscalePages[pageIndex] = grayscale;
+        return grayscale;
+    }
+
+    // Converts a pixel as laid out in a tile buffer to 0xAARRGGBB
+    static double toArgb(uint32_t pixel, const TileFormatSpec& format, bool gray) {
+        if (gray) {
+            return (double)(0xff000000 | (pixel & 0xff) * 0x010101);
+        }
+        pixel = toFormatByteOrder(pixel, format.renderFlags);
+        if (format.opaque) {
+            pixel |= 0xff000000;
+        }
+        return (double)pixel;
+    }
+
+    // A tile of a single color carries no pixels, the viewer fills its rect instead
+    static RenderedTile toUniformTile(int tileWidth, int tileHeight, TileColorType colorType, double argb) {
+        return RenderedTile(allocateBuffer(0), tileWidth, tileHeight, 0, colorType, std::nullopt, argb, TileQuality::FULL);
+    }
+
+    // Draft tiles trade antialiasing and image quality for speed, and are rendered at a fraction
+    // of the requested resolution to be stretched by the viewer
+    static constexpr int kDraftRenderFlags = FPDF_RENDER_NO_SMOOTHTEXT | FPDF_RENDER_NO_SMOOTHIMAGE |
+                                             FPDF_RENDER_NO_SMOOTHPATH | FPDF_RENDER_LIMITEDIMAGECACHE;
+    static constexpr double kDraftScale = 0.5;
+
+    // Hash of the colors of a scheme, 0 when there is none. Tiles of each theme get their own cache
+    // entries, so switching themes back and forth keeps both sets cached.
+    static uint64_t toColorSchemeKey(const std::optional<ColorScheme>& colorScheme) {
+        if (!colorScheme) {
+            return 0;
+        }
+        uint64_t hash = kHashSeed;
+        for (double color : {colorScheme->pathFillColor, colorScheme->pathStrokeColor, colorScheme->textFillColor,
+                             colorScheme->textStrokeColor, colorScheme->backgroundColor}) {
+            hash = hashValue(hash, (uint32_t)color);
+        }
+        return hash | 1;
+    }
+
+    static TileKey toTileKey(const TileRequest& request, TileQuality quality) {
+        return TileKey{(int)request.pageNumber, request.row, request.column,
+                       std::max((int)request.tileWidth, 1), std::max((int)request.tileHeight, 1),
+                       request.scale, (int)request.pixelFormat, (int)request.colorMode, (int)quality,
+                       toColorSchemeKey(request.colorScheme)};
+    }
+
+    RenderedTile HybridPdfiumUtil::renderTile(const TileRequest& request) {
+        double renderMs;
+        return renderTile(request, true, renderMs);
+    }
+
+    RenderedTile HybridPdfiumUtil::renderTile(const TileRequest& request, bool coalesce, double& renderMs) {
+        renderMs = -1;
+        TileQuality quality = request.quality.value_or(TileQuality::FULL);
+        // A full quality tile serves draft requests as well
+        TileKey fullKey = toTileKey(request, TileQuality::FULL);
+        std::optional<RenderedTile> cached = m_tileCache.get(fullKey);
+        if (!cached && quality == TileQuality::DRAFT) {
+            cached = m_tileCache.get(toTileKey(request, TileQuality::DRAFT));
+        }
+        if (cached) {
+            return *cached;
+        }
+
+        // Tiles persisted by an earlier session need neither the document lock nor the page
+        uint64_t fingerprint = m_documentFingerprint;
+        if (fingerprint != 0) {
+            std::optional<RenderedTile> stored = m_diskTileCache.get(fingerprint, fullKey);
+            if (stored) {
+                m_tileCache.put(fullKey, *stored, -1);
+                return *stored;
+            }
+        }
+
+        // A tile another caller is already rendering is waited for rather than rendered again
+        TileKey key = toTileKey(request, quality);
+        InFlightRenders::Pending pending;
+        std::optional<InFlightRenders::Claim> claim;
+        if (coalesce) {
+            if (!m_inFlightRenders.claim(key, pending)) {
+                return m_inFlightRenders.wait(pending);
+            }
+            claim.emplace(m_inFlightRenders, key);
+        }
+
+        std::optional<RenderedTile> rendered;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+            FPDF_PAGE page = m_pdfDoc ? getPage(m_pdfDoc, (int)request.pageNumber) : nullptr;
+            if (!page) {
+                std::cerr << "Failed to load the page " << request.pageNumber << " for document." << std::endl;
+                RenderedTile empty(allocateBuffer(0), 0, 0, 0, toColorType(request.pixelFormat), std::nullopt, std::nullopt, TileQuality::FULL);
+                if (claim) {
+                    claim->complete(empty, renderMs);
+                }
+                return empty;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            rendered = quality == TileQuality::DRAFT
+                ? rasterizeTile(page, TileRequest(request.pageNumber, request.row * kDraftScale, request.column * kDraftScale,
+                                                  request.tileWidth, request.tileHeight, request.scale * kDraftScale,
+                                                  request.pixelFormat, request.colorMode, quality, request.colorScheme),
+                                std::max((int)std::ceil(key.width * kDraftScale), 1),
+                                std::max((int)std::ceil(key.height * kDraftScale), 1), kDraftRenderFlags)
+                : rasterizeTile(page, request, key.width, key.height, 0);
+            renderMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            rendered->quality = quality;
+            m_tileCache.put(key, *rendered, renderMs);
+
+            if (quality == TileQuality::DRAFT) {
+                TileRequest fullRequest = request;
+                fullRequest.quality = TileQuality::FULL;
+                m_tileUpgrader.addDraft(key, fullRequest, m_documentId, renderMs);
+            }
+            // Taken again under the lock, the document may have changed since the lookup
+            fingerprint = m_documentFingerprint;
+        }
+        if (claim) {
+            claim->complete(*rendered, renderMs);
+        }
+
+        // Drafts are replaced soon, only full quality tiles are worth persisting
+        if (quality == TileQuality::FULL && fingerprint != 0) {
+            m_diskTileCache.put(fingerprint, key, *rendered);
+        }
+        return *rendered;
+    }
+
+    bool HybridPdfiumUtil::setDiskCacheDirectory(const std::string& directory, double maxBytes) {
+        if (directory.empty()) {
+            m_diskTileCache.close();
+            return true;
+        }
+        return m_diskTileCache.open(directory, (size_t)maxBytes);
+    }
+
+    void HybridPdfiumUtil::setInteractionState(bool moving) {
+        m_tileUpgrader.setMoving(moving);
+    }
+
+    void HybridPdfiumUtil::setTileUpgradeListener(const std::function<void(const TileRequest&)>& onUpgraded) {
+        m_tileUpgrader.setListener(onUpgraded);
+    }
+
+    double HybridPdfiumUtil::scheduleRender(const TileRequest& request, RenderPriority priority, double deadlineMs,
+                                            const std::optional<std::function<void(const std::optional<RenderedTile>&)>>& onRendered) {
+        int documentId;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+            documentId = m_documentId;
+        }
+        return m_renderScheduler.schedule(request, priority, deadlineMs, documentId,
+            [this, onRendered](int id, const TileRequest& scheduled, const std::optional<RenderedTile>& tile) {
+                // Finished tiles also go out with the next onTilesReady batch
+                if (tile) {
+                    m_tilesReady.push(ReadyTile(id, scheduled, *tile));
+                }
+                if (onRendered) {
+                    (*onRendered)(tile);
+                }
+            });
+    }
+
+    void HybridPdfiumUtil::setTilesReadyListener(const std::function<void(const std::vector<ReadyTile>&)>& onTilesReady, double frameIntervalMs) {
+        m_tilesReady.setListener(onTilesReady, frameIntervalMs);
+    }
+
+    bool HybridPdfiumUtil::cancelRender(double id) {
+        return m_renderScheduler.cancel((int)id);
+    }
+
+    RenderSchedulerStats HybridPdfiumUtil::getRenderSchedulerStats() {
+        RenderSchedulerStatsData stats = m_renderScheduler.getStats();
+        return RenderSchedulerStats(stats.queueDepth, stats.visibleQueueDepth, stats.completed, stats.dropped,
+                                    stats.downgraded, stats.averageWaitMs, stats.maxWaitMs, stats.averageVisibleWaitMs);
+    }
+
+    TileCacheStats HybridPdfiumUtil::getTileCacheStats() {
+        TieredTileCacheStats stats = m_tileCache.getStats();
+        DiskTileCacheStats diskStats = m_diskTileCache.getStats();
+        InFlightRenderStats inFlightStats = m_inFlightRenders.getStats();
+        return TileCacheStats(stats.hotTiles, stats.hotBytes, stats.compressedTiles, stats.compressedBytes,
+                              stats.uncompressedBytes, stats.hotHits, stats.compressedHits, stats.misses,
+                              stats.averageDecompressMs, stats.averageRenderMs,
+                              diskStats.tiles, diskStats.bytes, diskStats.hits,
+                              inFlightStats.coalescedRequests, inFlightStats.savedMs);
+    }
+
+    RenderQualityStats HybridPdfiumUtil::getRenderQualityStats() {
+        TileUpgradeStats stats = m_tileUpgrader.getStats();
+        return RenderQualityStats(stats.draftTiles, stats.upgradedTiles, stats.pendingUpgrades,
+                                  stats.draftRenderMs, stats.upgradeRenderMs, stats.savedMs);
+    }
+
+    RenderedTile HybridPdfiumUtil::rasterizeTile(FPDF_PAGE page, const TileRequest& request, int tileWidth, int tileHeight, int extraFlags) {
+        TileFormatSpec format = getTileFormatSpec(request.pixelFormat);
+        TileColorMode mode = request.colorMode;
+        bool gray = mode == TileColorMode::GRAY ||
+                    (mode != TileColorMode::COLOR && isGrayscale(page, (int)request.pageNumber));
+        TileColorType colorType = gray ? (mode == TileColorMode::PALETTE ? TileColorType::PALETTE4 : TileColorType::GRAY8)
+                                       : toColorType(request.pixelFormat);
+
+        // Background the page is drawn on, in the tile's color space
+        uint32_t background = request.colorScheme ? (uint32_t)request.colorScheme->backgroundColor : 0xffffffff;
+        if (gray) {
+            uint32_t luma = (((background >> 16) & 0xff) * 77 + ((background >> 8) & 0xff) * 150 + (background & 0xff) * 29) >> 8;
+            background = 0xff000000 | luma * 0x010101;
+        }
+
+        // Tiles past the page edges are background only and need no rendering at all
+        double pageWidth = FPDF_GetPageWidthF(page) * request.scale;
+        double pageHeight = FPDF_GetPageHeightF(page) * request.scale;
+        if (request.column >= tileWidth || request.column + pageWidth <= 0 ||
+            request.row >= tileHeight || request.row + pageHeight <= 0) {
+            return toUniformTile(tileWidth, tileHeight, colorType, (double)background);
+        }
+
+        // Whitespace between content needs no rendering either
+        FS_RECTF clip;
+        if (!getContentClip(getOccupancy(page, (int)request.pageNumber), tileWidth, tileHeight,
+                            request.row, request.column, request.scale, clip)) {
+            return toUniformTile(tileWidth, tileHeight, colorType, (double)background);
+        }
+
+        // Gray pages are rendered straight into a one byte per pixel bitmap
+        int bitmapFormat = gray ? FPDFBitmap_Gray : format.bitmapFormat;
+        int bytesPerPixel = gray ? 1 : format.bytesPerPixel;
+        int stride = tileWidth * bytesPerPixel;
+        std::shared_ptr<ArrayBuffer> buf = allocateBuffer((size_t)stride * tileHeight);
+        renderTileBitmap(page, (int)request.pageNumber, bitmapFormat, buf->data(), stride, tileWidth, tileHeight,
+                         request.row, request.column, request.scale, clip,
+                         (gray ? FPDF_GRAYSCALE : format.renderFlags) | extraFlags, request.colorScheme);
+
+        // Margins and whitespace render to a single color
+        uint32_t pixel;
+        if (findUniformPixel(buf->data(), tileWidth, tileHeight, stride, bytesPerPixel, gray || format.opaque, pixel)) {
+            return toUniformTile(tileWidth, tileHeight, colorType, toArgb(pixel, format, gray));
+        }
+
+        if (gray) {
+            if (mode == TileColorMode::PALETTE) {
+                return toRenderedTile(packGrayToPalette4(buf->data(), tileWidth, tileHeight, stride), tileWidth, tileHeight);
+            }
+            return RenderedTile(buf, tileWidth, tileHeight, stride, TileColorType::GRAY8, std::nullopt, std::nullopt, TileQuality::FULL);
+        }
+
+        // Flat color content (diagrams, highlighted text) often fits a 16 color palette exactly
+        if (mode == TileColorMode::PALETTE || mode == TileColorMode::AUTO) {
+            Palette4Tile packed;
+            if (tryPackColorToPalette4(buf->data(), tileWidth, tileHeight, stride, format.opaque, packed)) {
+                return toRenderedTile(packed, tileWidth, tileHeight);
+            }
+        }
+        return RenderedTile(buf, tileWidth, tileHeight, stride, colorType, std::nullopt, std::nullopt, TileQuality::FULL);
+    }
+
+    RenderedTile HybridPdfiumUtil::renderGridTile(double x, double y, double scale, double gapColor) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        const ViewportOptions& options = m_viewportOptions;
+        TileFormatSpec format = getTileFormatSpec(options.pixelFormat);
+        TileColorType colorType = toColorType(options.pixelFormat);
+        double pixelRatio = options.pixelRatio > 0 ? options.pixelRatio : 1;
+        double renderScale = scale * pixelRatio;
+        int tilePixels = std::max((int)(options.tileSize * pixelRatio), 1);
+        if (!ensurePageGeometry() || scale <= 0) {
+            return toUniformTile(tilePixels, tilePixels, colorType, gapColor);
+        }
+
+        // Grid tiles are cached under page -1, the gap color and layout that shape them folded
+        // into the color scheme slot
+        uint64_t layoutKey = kHashSeed;
+        for (double value : {gapColor, (double)m_pageGeometry.getMode(), m_pageGeometry.getPageGap(), m_pageGeometry.getSpreadGap()}) {
+            layoutKey = hashValue(layoutKey, value);
+        }
+        TileKey key{-1, y * pixelRatio, x * pixelRatio, tilePixels, tilePixels, renderScale,
+                    (int)options.pixelFormat, 0, (int)TileQuality::FULL, layoutKey};
+        std::optional<RenderedTile> cached = m_tileCache.get(key);
+        if (cached) {
+            return *cached;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        int firstPage, lastPage;
+        if (!m_pageGeometry.getPagesInRect(x / scale, y / scale, (x + options.tileSize) / scale, (y + options.tileSize) / scale,
+                                           firstPage, lastPage) ||
+            x + options.tileSize <= 0 || x >= m_pageGeometry.getContentWidth() * scale ||
+            y + options.tileSize <= 0 || y >= m_pageGeometry.getContentHeight() * scale) {
+            RenderedTile tile = toUniformTile(tilePixels, tilePixels, colorType, gapColor);
+            m_tileCache.put(key, tile, -1);
+            return tile;
+        }
+
+        int stride = tilePixels * format.bytesPerPixel;
+        std::shared_ptr<ArrayBuffer> buf = allocateBuffer((size_t)stride * tilePixels);
+        uint32_t fill = toFormatByteOrder((uint32_t)gapColor, format.renderFlags);
+        FPDF_BITMAP bitmap = FPDFBitmap_CreateEx(tilePixels, tilePixels, format.bitmapFormat, buf->data(), stride);
+        if (!bitmap) {
+            std::cerr << "Failed to load the bitmap handle for document." << std::endl;
+            return toUniformTile(tilePixels, tilePixels, colorType, gapColor);
+        }
+        FPDFBitmap_FillRect(bitmap, 0, 0, tilePixels, tilePixels, fill);
+
+        // Each page renders straight into its slice of the tile, the gaps keep the fill
+        for (int pageIndex = firstPage; pageIndex <= lastPage; pageIndex++) {
+            double pageLeft = (m_pageGeometry.getPageLeft(pageIndex) * scale - x) * pixelRatio;
+            double pageTop = (m_pageGeometry.getPageTop(pageIndex) * scale - y) * pixelRatio;
+            int left = std::max((int)std::round(pageLeft), 0);
+            int top = std::max((int)std::round(pageTop), 0);
+            int right = std::min((int)std::round(pageLeft + m_pageGeometry.getPageWidth(pageIndex) * renderScale), tilePixels);
+            int bottom = std::min((int)std::round(pageTop + m_pageGeometry.getPageHeight(pageIndex) * renderScale), tilePixels);
+            if (right <= left || bottom <= top) {
+                continue;
+            }
+            FPDF_PAGE page = getPage(m_pdfDoc, pageIndex);
+            if (!page) {
+                std::cerr << "Failed to load the page " << pageIndex << " for document." << std::endl;
+                continue;
+            }
+
+            int sliceWidth = right - left, sliceHeight = bottom - top;
+            double row = pageTop - top, column = pageLeft - left;
+            FS_RECTF clip;
+            if (getContentClip(getOccupancy(page, pageIndex), sliceWidth, sliceHeight, row, column, renderScale, clip)) {
+                renderTileBitmap(page, pageIndex, format.bitmapFormat, buf->data() + (size_t)top * stride + left * format.bytesPerPixel,
+                                 stride, sliceWidth, sliceHeight, row, column, renderScale, clip, format.renderFlags, std::nullopt);
+            } else {
+                FPDFBitmap_FillRect(bitmap, left, top, sliceWidth, sliceHeight, 0xffffffff);
+            }
+        }
+        FPDFBitmap_Destroy(bitmap);
+
+        uint32_t pixel;
+        RenderedTile tile = findUniformPixel(buf->data(), tilePixels, tilePixels, stride, format.bytesPerPixel, format.opaque, pixel)
+            ? toUniformTile(tilePixels, tilePixels, colorType, toArgb(pixel, format, false))
+            : RenderedTile(buf, tilePixels, tilePixels, stride, colorType, std::nullopt, std::nullopt, TileQuality::FULL);
+        m_tileCache.put(key, tile, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        return tile;
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridPdfiumUtil::configureAtlas(double slotSize, double columns, double rows, PixelFormat pixelFormat) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        m_atlas = std::make_unique<TileAtlas>((int)slotSize, (int)columns, (int)rows);
+        m_atlasFormat = pixelFormat;
+        m_atlasStride = (int)std::max(columns, 1.0) * m_atlas->getSlotSize() * getTileFormatSpec(pixelFormat).bytesPerPixel;
+        m_atlasBuffer = allocateBuffer((size_t)m_atlasStride * (int)std::max(rows, 1.0) * m_atlas->getSlotSize());
+        return m_atlasBuffer;
+    }
+
+    std::vector<AtlasEntry> HybridPdfiumUtil::renderAtlasBatch(const std::vector<TileRequest>& requests) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        std::vector<AtlasEntry> entries;
+        if (!m_atlas) {
+            std::cerr << "configureAtlas has to be called before renderAtlasBatch." << std::endl;
+            return entries;
+        }
+        TileFormatSpec format = getTileFormatSpec(m_atlasFormat);
+        int slotSize = m_atlas->getSlotSize();
+        entries.reserve(requests.size());
+        for (size_t i = 0; i < requests.size(); i++) {
+            const TileRequest& request = requests[i];
+            // Slots used earlier in the batch are the most recently used ones, so recycling stays
+            // clear of them as long as the batch fits the atlas
+            if (i >= (size_t)m_atlas->getSlotCount()) {
+                entries.emplace_back(-1, 0, 0, 0, 0, false);
+                continue;
+            }
+            TileKey key = toTileKey(request, TileQuality::FULL);
+            key.pixelFormat = (int)m_atlasFormat;
+            key.colorMode = 0;
+            key.colorScheme = 0;
+            int width = std::min(key.width, slotSize);
+            int height = std::min(key.height, slotSize);
+
+            int slot = m_atlas->find(key);
+            bool rendered = slot < 0;
+            if (rendered) {
+                slot = m_atlas->assign(key);
+                uint8_t* pixels = m_atlasBuffer->data() + (size_t)m_atlas->getSlotY(slot) * m_atlasStride +
+                                  (size_t)m_atlas->getSlotX(slot) * format.bytesPerPixel;
+                if (!drawTile(pixels, m_atlasStride, (int)request.pageNumber, request.row, request.column,
+                              width, height, request.scale, format)) {
+                    // The slot holds whatever was drawn there before, which must not pass for this tile
+                    m_atlas->release(slot);
+                    entries.emplace_back(-1, 0, 0, 0, 0, false);
+                    continue;
+                }
+            }
+            entries.emplace_back(slot, m_atlas->getSlotX(slot), m_atlas->getSlotY(slot), width, height, rendered);
+        }
+        return entries;
+    }
+
+    void HybridPdfiumUtil::startTextIndex() {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        if (!m_pdfDoc) {
+            std::cerr << "No PDF document was loaded" << std::endl;
+            return;
+        }
+        if (m_textIndex.isRunning()) {
+            return;
+        }
+
+        int pageCount = FPDF_GetPageCount(m_pdfDoc);
+        m_textIndex.start(pageCount, [this](int pageIndex, std::u16string& text) {
+            bool loaded = false;
+            visitPage(pageIndex, [&](FPDF_PAGE page) {
+                FPDF_TEXTPAGE textPage = FPDFText_LoadPage(page);
+                if (textPage) {
+                    text = getPageText(textPage, 0, FPDFText_CountChars(textPage));
+                    FPDFText_ClosePage(textPage);
+                    loaded = true;
+                }
+            });
+            return loaded;
+        });
+    }
+
+    double HybridPdfiumUtil::getTextIndexProgress() {
+        return m_textIndex.getIndexedPageCount();
+    }
+
+    std::vector<TextRange> HybridPdfiumUtil::searchTextIndex(const std::string& query, double maxResults) {
+        std::vector<TextRange> results;
+        std::vector<TextIndexHit> hits = m_textIndex.search(query, (size_t)std::max(maxResults, 0.0));
+        results.reserve(hits.size());
+        for (const TextIndexHit& hit : hits) {
+            results.emplace_back(hit.page, hit.charIndex, hit.charCount);
+        }
+        return results;
+    }
+
+    std::vector<double> HybridPdfiumUtil::getTextRects(double pageNumber, double charIndex, double charCount) {
+        std::vector<double> rects;
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        TextPageEntry* entry = getTextPage((int)pageNumber);
+        if (!entry) {
+            return rects;
+        }
+
+        // PDFium reports rects in PDF space with the origin at the bottom left. Map them to the
+        // displayed page used for tiles and page dimensions.
+        int rectCount = FPDFText_CountRects(entry->textPage, (int)charIndex, (int)charCount);
+        rects.reserve(rectCount * 4);
+        for (int i = 0; i < rectCount; i++) {
+            double left, top, right, bottom;
+            if (FPDFText_GetRect(entry->textPage, i, &left, &top, &right, &bottom)) {
+                float displayLeft, displayTop, displayRight, displayBottom;
+                entry->transform.toDisplay(left, top, right, bottom, displayLeft, displayTop, displayRight, displayBottom);
+                rects.push_back(displayLeft);
+                rects.push_back(displayTop);
+                rects.push_back(displayRight);
+                rects.push_back(displayBottom);
+            }
+        }
+        return rects;
+    }
+
+    double HybridPdfiumUtil::searchAsync(const std::string& query, double flags, double startPage, double resultsPerBatch,
+                                         const std::function<void(double, const std::vector<TextRange>&, bool)>& onResults) {
+        int pageCount = 0;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+            if (!m_pdfDoc) {
+                std::cerr << "No PDF document was loaded" << std::endl;
+                return -1;
+            }
+            pageCount = FPDF_GetPageCount(m_pdfDoc);
+        }
+
+        return m_textSearch.start(utf8ToUtf16(query), (unsigned long)flags, pageCount, (int)startPage,
+                                  (size_t)std::max(resultsPerBatch, 1.0),
+                                  [onResults](int searchId, const std::vector<TextIndexHit>& hits, bool done) {
+            std::vector<TextRange> results;
+            results.reserve(hits.size());
+            for (const TextIndexHit& hit : hits) {
+                results.emplace_back(hit.page, hit.charIndex, hit.charCount);
+            }
+            onResults(searchId, results, done);
+        });
+    }
+
+    void HybridPdfiumUtil::cancelSearch() {
+        m_textSearch.cancel();
+    }
+
+    double HybridPdfiumUtil::getCharIndexAtPos(double pageNumber, double x, double y, double tolerance) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        TextPageEntry* entry = getTextPage((int)pageNumber);
+        if (!entry) {
+            return -1;
+        }
+        return entry->getCharGrid().charIndexAt(x, y, tolerance);
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridPdfiumUtil::getCharRangesInRect(double pageNumber, double left, double top, double right, double bottom) {
+        std::vector<int32_t> ranges;
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+            TextPageEntry* entry = getTextPage((int)pageNumber);
+            if (entry) {
+                ranges = entry->getCharGrid().charRangesInRect(left, top, right, bottom);
+            }
+        }
+
+        // Packed Int32 [charIndex, charCount] pairs
+        return copyToBuffer(ranges.data(), ranges.size() * sizeof(int32_t));
+    }
+
+    static TextSegment toTextSegment(const TextSegmentBox& segment) {
+        return TextSegment(segment.firstChar, segment.charCount, segment.left, segment.top, segment.right, segment.bottom);
+    }
+
+    std::optional<TextSegment> HybridPdfiumUtil::getWordAt(double pageNumber, double x, double y) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        TextPageEntry* entry = getTextPage((int)pageNumber);
+        if (!entry) {
+            return std::nullopt;
+        }
+        std::optional<TextSegmentBox> word = entry->getSegmentation().wordAt(entry->getCharGrid(), x, y);
+        if (!word) {
+            return std::nullopt;
+        }
+        return toTextSegment(*word);
+    }
+
+    std::vector<TextSegment> HybridPdfiumUtil::getLinesInRect(double pageNumber, double left, double top, double right, double bottom) {
+        std::vector<TextSegment> lines;
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        TextPageEntry* entry = getTextPage((int)pageNumber);
+        if (!entry) {
+            return lines;
+        }
+        for (const TextSegmentBox& line : entry->getSegmentation().linesInRect(left, top, right, bottom)) {
+            lines.push_back(toTextSegment(line));
+        }
+        return lines;
+    }
+
+    std::optional<PageElement> HybridPdfiumUtil::hitTest(double pageNumber, double x, double y) {
+        std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+        if (!m_pdfDoc) {
+            std::cerr << "No PDF document was loaded" << std::endl;
+            return std::nullopt;
+        }
+
+        int pageIndex = (int)pageNumber;
+        FPDF_PAGE page = getPage(m_pdfDoc, pageIndex);
+        if (!page) {
+            std::cerr << "Failed to load the page " << pageNumber << " for document." << std::endl;
+            return std::nullopt;
+        }
+
+        // Built on the first tap of a page and evicted together with the page
+        auto it = m_pageElementCache.find(pageIndex);
+        if (it == m_pageElementCache.end()) {
+            it = m_pageElementCache.emplace(pageIndex, std::make_unique<PageElementIndex>(m_pdfDoc, page)).first;
+        }
+
+        const PageElementInfo* element = it->second->hitTest(x, y);
+        if (!element) {
+            return std::nullopt;
+        }
+        return PageElement(element->isLink ? PageElementKind::LINK : PageElementKind::ANNOTATION,
+                           element->subtype, element->annotIndex,
+                           element->left, element->top, element->right, element->bottom,
+                           element->destPage, element->uri);
+    }
 }
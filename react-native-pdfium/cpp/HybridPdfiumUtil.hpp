@@ -1,28 +1,137 @@
 #pragma once
 #include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include "HybridPdfiumUtilSpec.hpp"
 #include "fpdfview.h"
 #include "fpdf_text.h"
+#include "TileAtlas.hpp"
 #include "TileCache.hpp"
+#include "TieredTileCache.hpp"
+#include "DiskTileCache.hpp"
+#include "DocumentSidecar.hpp"
+#include "InFlightRenders.hpp"
+#include "TileKey.hpp"
+#include "TileUpgrader.hpp"
+#include "TextIndex.hpp"
+#include "TextSearch.hpp"
+#include "TextPageCache.hpp"
+#include "PageElementIndex.hpp"
+#include "PageGeometry.hpp"
+#include "PageOccupancy.hpp"
+#include "RegionRenderer.hpp"
+#include "RenderScheduler.hpp"
+#include "TileEncoding.hpp"
+#include "TileFormats.hpp"
+#include "TileReadyDispatcher.hpp"
 
 
 namespace margelo::nitro::pdfium {
 
     class HybridPdfiumUtil: public HybridPdfiumUtilSpec {
         public:
-        HybridPdfiumUtil() : HybridObject(TAG), HybridPdfiumUtilSpec(), m_pdfDoc(nullptr) {
+        HybridPdfiumUtil() : HybridObject(TAG), HybridPdfiumUtilSpec(), m_pdfDoc(nullptr),
+            m_textSearch([this](int pageIndex, const std::function<void(FPDF_PAGE)>& visit) { return visitPage(pageIndex, visit); }),
+            m_tileCache(kTileCacheEntries, kTileCacheBytes, kCompressedTileEntries, kCompressedTileBytes),
+            m_viewportOptions(kDefaultTileSize, kDefaultPixelRatio, LayoutMode::VERTICAL, kDefaultPageGap, kDefaultPageGap,
+                              PixelFormat::RGBX, TileColorMode::COLOR),
+            m_tileUpgrader([this](const TileRequest& request, int documentId) {
+                std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+                if (documentId != m_documentId) {
+                    return -1.0;
+                }
+                auto start = std::chrono::steady_clock::now();
+                // Not coalesced, a caller waiting for the lock could own the same tile
+                double renderMs;
+                renderTile(request, false, renderMs);
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }),
+            m_renderScheduler([this](const TileRequest& request, int documentId, double& renderMs) -> std::optional<RenderedTile> {
+                {
+                    std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+                    if (documentId != m_documentId) {
+                        return std::nullopt;
+                    }
+                }
+                // Rendered without holding the lock so identical requests coalesce
+                RenderedTile tile = renderTile(request, true, renderMs);
+                std::lock_guard<std::recursive_mutex> lock(m_pdfMutex);
+                if (documentId != m_documentId) {
+                    return std::nullopt;
+                }
+                return tile;
+            }) {
                 FPDF_InitLibrary();
+                m_pageGeometry.setLayout(LayoutMode::VERTICAL, kDefaultPageGap, kDefaultPageGap);
             }
             
             double add(double a, double b) override;
             void openPdf(const std::string& filePath) override;
             void closePdf() override;
+            void openPdfAsync(const std::string& filePath, const std::optional<TileRequest>& initialTile,
+                              const std::function<void(double, const std::optional<RenderedTile>&)>& onOpened,
+                              const std::function<void(double, const std::vector<double>&, bool)>& onPageSizes) override;
+            OpenTimings getOpenTimings() override;
             double getPageCount() override;
             std::vector<std::tuple<double, double, double>> getAllPageDimensions() override;
+            void setSidecarDirectory(const std::string& directory) override;
+            std::vector<OutlineItem> getOutline() override;
+            std::string getPageLabel(double pageNumber) override;
+            double getNamedDestinationPage(const std::string& name) override;
             
-            std::shared_ptr<ArrayBuffer> getTile(double pageNumber, double row, double column, double displayWidth, double tileWidth, double tileHeight, double scale) override;
+            std::shared_ptr<ArrayBuffer> getTile(double pageNumber, double row, double column, double displayWidth, double tileWidth, double tileHeight, double scale, PixelFormat pixelFormat) override;
+            bool getTileInto(const std::shared_ptr<ArrayBuffer>& target, double offset, double rowBytes,
+                             double pageNumber, double row, double column, double tileWidth, double tileHeight,
+                             double scale, PixelFormat pixelFormat) override;
             std::shared_ptr<ArrayBuffer> getTileBgr565(double pageNumber, double row, double column, double displayWidth, double tileWidth, double tileHeight, double scale) override;
+            RenderedTile renderTile(const TileRequest& request) override;
+            void setViewportOptions(const ViewportOptions& options) override;
+            std::shared_ptr<ArrayBuffer> getPageGeometry(double firstPage, double count) override;
+            std::vector<double> getPageRange(double start, double end) override;
+            std::vector<double> getLayoutSize() override;
+            double getFitWidthScale(double viewportWidth) override;
+            std::vector<double> getVisiblePages(double offsetX, double offsetY, double scale, double width, double height) override;
+            std::vector<ViewportTile> renderViewport(double offsetX, double offsetY, double scale, double width, double height) override;
+            RenderedTile renderGridTile(double x, double y, double scale, double gapColor) override;
+            std::shared_ptr<ArrayBuffer> configureAtlas(double slotSize, double columns, double rows, PixelFormat pixelFormat) override;
+            std::vector<AtlasEntry> renderAtlasBatch(const std::vector<TileRequest>& requests) override;
+            void setLargePageMode(bool enabled) override;
+            void setInteractionState(bool moving) override;
+            void setTileUpgradeListener(const std::function<void(const TileRequest& /* request */)>& onUpgraded) override;
+            RenderQualityStats getRenderQualityStats() override;
+            double scheduleRender(const TileRequest& request, RenderPriority priority, double deadlineMs,
+                                  const std::optional<std::function<void(const std::optional<RenderedTile>&)>>& onRendered) override;
+            void setTilesReadyListener(const std::function<void(const std::vector<ReadyTile>&)>& onTilesReady, double frameIntervalMs) override;
+            bool cancelRender(double id) override;
+            RenderSchedulerStats getRenderSchedulerStats() override;
+            TileCacheStats getTileCacheStats() override;
+            bool setDiskCacheDirectory(const std::string& directory, double maxBytes) override;
+
+            void startTextIndex() override;
+            double getTextIndexProgress() override;
+            std::vector<TextRange> searchTextIndex(const std::string& query, double maxResults) override;
+            std::vector<double> getTextRects(double pageNumber, double charIndex, double charCount) override;
+            double searchAsync(const std::string& query, double flags, double startPage, double resultsPerBatch,
+                               const std::function<void(double, const std::vector<TextRange>&, bool)>& onResults) override;
+            void cancelSearch() override;
+
+            double getCharIndexAtPos(double pageNumber, double x, double y, double tolerance) override;
+            std::shared_ptr<ArrayBuffer> getCharRangesInRect(double pageNumber, double left, double top, double right, double bottom) override;
+            std::optional<TextSegment> getWordAt(double pageNumber, double x, double y) override;
+            std::vector<TextSegment> getLinesInRect(double pageNumber, double left, double top, double right, double bottom) override;
+
+            std::optional<PageElement> hitTest(double pageNumber, double x, double y) override;
+
             ~HybridPdfiumUtil() {
+                cancelOpen();
+                m_textIndex.stop();
+                m_textSearch.stop();
+                m_tileUpgrader.stop();
+                m_renderScheduler.stop();
+                m_tilesReady.stop();
+                m_sidecar.close();
                 clearPageCache();
                 if (m_pdfDoc != nullptr) {
                     FPDF_CloseDocument(m_pdfDoc);  // Clean up the loaded document resource
@@ -31,8 +140,80 @@ namespace margelo::nitro::pdfium {
             }
     private:
         FPDF_DOCUMENT m_pdfDoc;
+        // PDFium is not thread safe. Every call into it, including the ones made by background
+        // workers, has to hold this lock.
+        std::recursive_mutex m_pdfMutex;
+        int m_documentId = 0; // Bumped whenever the document closes, guarded by m_pdfMutex
+        TextIndex m_textIndex;
+        TextSearch m_textSearch;
         std::unordered_map<int, FPDF_PAGE> m_pageCache;
+        TextPageCache m_textPageCache;
+        std::unordered_map<int, std::unique_ptr<PageElementIndex>> m_pageElementCache;
+        std::unordered_map<int, std::unique_ptr<PageOccupancy>> m_pageOccupancyCache;
+        std::unordered_map<int, bool> m_grayscalePages; // Page classification for TileColorMode::AUTO
+        // Tiles returned by renderTile, weighed by their pixel bytes. Uniform tiles carry no
+        // pixels, so they only count against the entry limits.
+        static constexpr size_t kTileCacheEntries = 4096;
+        static constexpr size_t kTileCacheBytes = 48 * 1024 * 1024;
+        static constexpr size_t kCompressedTileEntries = 16384;
+        static constexpr size_t kCompressedTileBytes = 16 * 1024 * 1024;
+        TieredTileCache m_tileCache;
+        InFlightRenders m_inFlightRenders;
+        DiskTileCache m_diskTileCache;
+        std::atomic<uint64_t> m_documentFingerprint{0}; // Disk cache key of the open document, 0 if none
+        // Page layout and tiling of renderViewport, matching the viewer's defaults
+        static constexpr double kDefaultTileSize = 256;
+        static constexpr double kDefaultPixelRatio = 2;
+        static constexpr double kDefaultPageGap = 10;
+        static constexpr int kPageGeometryLanes = 5; // Width, height, left, top, rotation
+        ViewportOptions m_viewportOptions;
+        PageGeometry m_pageGeometry; // Filled on first use, guarded by m_pdfMutex
+        // Atlas of renderAtlasBatch, null until configureAtlas. Guarded by m_pdfMutex.
+        std::unique_ptr<TileAtlas> m_atlas;
+        std::shared_ptr<ArrayBuffer> m_atlasBuffer;
+        PixelFormat m_atlasFormat = PixelFormat::RGBX;
+        int m_atlasStride = 0;
+        std::string m_sidecarDirectory; // Sidecars are off while empty
+        DocumentSidecar m_sidecar;
+        // openPdfAsync runs on this thread, page sizes are streamed in batches of this many pages
+        static constexpr int kPageSizeBatch = 512;
+        std::thread m_openThread;
+        std::atomic<bool> m_openCancelled{false};
+        std::mutex m_openTimingsMutex;
+        struct {
+            double loadMs = 0;
+            double firstPageMs = 0;
+            double firstTileMs = 0;
+            double geometryMs = 0;
+        } m_openTimings;
+        bool m_largePageMode = false;
+        RegionRenderer m_regionRenderer;
+        TileUpgrader m_tileUpgrader;
+        RenderScheduler m_renderScheduler;
+        TileReadyDispatcher m_tilesReady; // Batches scheduled renders for the onTilesReady listener
+        bool loadDocument(const std::string& filePath);
+        bool ensurePageGeometry();
+        void closeDocument();
+        // Stops a running openPdfAsync. Must not be called while holding the document lock.
+        void cancelOpen();
         FPDF_PAGE getPage(FPDF_DOCUMENT m_pdfDoc, int pageIndex);
+        TextPageEntry* getTextPage(int pageIndex);
+        bool isGrayscale(FPDF_PAGE page, int pageIndex);
+        const PageOccupancy& getOccupancy(FPDF_PAGE page, int pageIndex);
+        void renderPageClip(FPDF_BITMAP bitmap, FPDF_PAGE page, int pageIndex, const FS_MATRIX& matrix, const FS_RECTF& clip, int flags);
+        // Renders the tile of getTile and getTileInto into `buffer`, rows `stride` bytes apart
+        bool drawTile(uint8_t* buffer, int stride, int pageNumber, double row, double column,
+                      int tileWidth, int tileHeight, double scale, const TileFormatSpec& format);
+        bool renderTileBitmap(FPDF_PAGE page, int pageIndex, int bitmapFormat, uint8_t* buffer, int stride,
+                              int tileWidth, int tileHeight, double row, double column, double scale,
+                              const FS_RECTF& clip, int flags, const std::optional<ColorScheme>& colorScheme);
+        // Renders and caches a tile missing from the caches. Coalesced renders wait for an
+        // identical render under way, which callers holding the document lock must not do.
+        // renderMs is set to the time spent rasterizing, negative if the tile was not rasterized
+        // here but taken from a cache or another caller's render.
+        RenderedTile renderTile(const TileRequest& request, bool coalesce, double& renderMs);
+        RenderedTile rasterizeTile(FPDF_PAGE page, const TileRequest& request, int tileWidth, int tileHeight, int extraFlags);
+        bool visitPage(int pageIndex, const std::function<void(FPDF_PAGE)>& visit);
         void clearPageCache();
         void cleanupDistantPages(int currentPageIndex);
         LRUCache<int, std::string> cache();
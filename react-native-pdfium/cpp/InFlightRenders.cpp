@@ -0,0 +1,61 @@
+#include "InFlightRenders.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    bool InFlightRenders::claim(const TileKey& key, Pending& pending) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_entries.try_emplace(key);
+        if (inserted) {
+            it->second = std::make_shared<Entry>();
+            return true;
+        }
+        pending = it->second->result;
+        return false;
+    }
+
+    void InFlightRenders::complete(const TileKey& key, const RenderedTile& tile, double renderMs) {
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(key);
+            if (it == m_entries.end()) {
+                return;
+            }
+            entry = std::move(it->second);
+            m_entries.erase(it);
+        }
+        // Waiters are woken outside the table lock
+        entry->promise.set_value(Result{tile, renderMs});
+    }
+
+    void InFlightRenders::abandon(const TileKey& key) {
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(key);
+            if (it == m_entries.end()) {
+                return;
+            }
+            entry = std::move(it->second);
+            m_entries.erase(it);
+        }
+        entry->promise.set_exception(m_abandoned);
+    }
+
+    RenderedTile InFlightRenders::wait(const Pending& pending) {
+        const Result& result = pending.get();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.coalescedRequests++;
+        if (result.renderMs > 0) {
+            m_stats.savedMs += result.renderMs;
+        }
+        return result.tile;
+    }
+
+    InFlightRenderStats InFlightRenders::getStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        InFlightRenderStats stats = m_stats;
+        stats.inFlight = (int)m_entries.size();
+        return stats;
+    }
+}
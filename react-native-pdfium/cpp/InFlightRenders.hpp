@@ -0,0 +1,75 @@
+#pragma once
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include "RenderedTile.hpp"
+#include "TileKey.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    struct InFlightRenderStats {
+        int coalescedRequests = 0; // Requests served by a render another caller started
+        double savedMs = 0;        // Render time those requests would have cost
+        int inFlight = 0;
+    };
+
+    // Tiles being rendered, so that requests for a tile that is already under way wait for that
+    // render instead of queueing on the document lock to render it again. Every caller gets the
+    // same buffer.
+    class InFlightRenders {
+        public:
+            struct Result {
+                RenderedTile tile;
+                double renderMs; // Negative if the render failed
+            };
+            using Pending = std::shared_future<Result>;
+
+            // Returns true if the caller is the first to ask for the tile. It must then render it
+            // and call complete. Otherwise `pending` is set to the render under way.
+            bool claim(const TileKey& key, Pending& pending);
+            void complete(const TileKey& key, const RenderedTile& tile, double renderMs);
+            // Gives up a claimed render, its waiters throw instead of getting a tile
+            void abandon(const TileKey& key);
+            // Waits for a render claimed by another caller
+            RenderedTile wait(const Pending& pending);
+            InFlightRenderStats getStats();
+
+            // Abandons a claimed render unless it is completed, so that waiters fail rather than
+            // block forever when rendering throws
+            class Claim {
+                public:
+                    Claim(InFlightRenders& renders, const TileKey& key) : m_renders(renders), m_key(key) {}
+                    Claim(const Claim&) = delete;
+                    Claim& operator=(const Claim&) = delete;
+                    ~Claim() {
+                        if (!m_completed) {
+                            m_renders.abandon(m_key);
+                        }
+                    }
+
+                    void complete(const RenderedTile& tile, double renderMs) {
+                        m_completed = true;
+                        m_renders.complete(m_key, tile, renderMs);
+                    }
+
+                private:
+                    InFlightRenders& m_renders;
+                    TileKey m_key;
+                    bool m_completed = false;
+            };
+
+        private:
+            struct Entry {
+                std::promise<Result> promise;
+                Pending result = promise.get_future().share();
+            };
+
+            std::mutex m_mutex;
+            std::unordered_map<TileKey, std::shared_ptr<Entry>> m_entries;
+            InFlightRenderStats m_stats;
+            // Made up front, abandon() runs while unwinding and must not allocate
+            std::exception_ptr m_abandoned = std::make_exception_ptr(std::runtime_error("The tile render was abandoned"));
+    };
+}
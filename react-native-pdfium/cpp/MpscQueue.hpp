@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::pdfium {
+
+    // Lock-free multi-producer single-consumer queue. Producers push with a single
+    // compare-and-swap on the list head, the consumer takes the whole list with one exchange and
+    // restores arrival order. Taking everything at once leaves no node for producers to race on.
+    template <typename T>
+    class MpscQueue {
+        public:
+            MpscQueue() = default;
+            MpscQueue(const MpscQueue&) = delete;
+            MpscQueue& operator=(const MpscQueue&) = delete;
+            ~MpscQueue() { deleteList(m_head.exchange(nullptr, std::memory_order_acquire)); }
+
+            void push(T value) {
+                Node* node = new Node{std::move(value), m_head.load(std::memory_order_relaxed)};
+                while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+                }
+            }
+
+            // Appends everything pushed so far to `out`, oldest first. Consumer thread only.
+            size_t drain(std::vector<T>& out) {
+                Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+                // The list is newest first
+                Node* reversed = nullptr;
+                while (node) {
+                    Node* next = node->next;
+                    node->next = reversed;
+                    reversed = node;
+                    node = next;
+                }
+                size_t count = 0;
+                while (reversed) {
+                    Node* next = reversed->next;
+                    out.push_back(std::move(reversed->value));
+                    delete reversed;
+                    reversed = next;
+                    count++;
+                }
+                return count;
+            }
+
+            bool empty() const { return m_head.load(std::memory_order_relaxed) == nullptr; }
+
+        private:
+            struct Node {
+                T value;
+                Node* next;
+            };
+
+            static void deleteList(Node* node) {
+                while (node) {
+                    Node* next = node->next;
+                    delete node;
+                    node = next;
+                }
+            }
+
+            std::atomic<Node*> m_head{nullptr};
+    };
+}
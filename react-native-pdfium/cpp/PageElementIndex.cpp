@@ -0,0 +1,101 @@
+#include "PageElementIndex.hpp"
+#include "fpdf_annot.h"
+#include "fpdf_doc.h"
+#include "PageTransform.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace margelo::nitro::pdfium {
+
+    static constexpr int kBandCount = 32;
+
+    namespace {
+        std::string getUriPath(FPDF_DOCUMENT document, FPDF_ACTION action) {
+            unsigned long length = FPDFAction_GetURIPath(document, action, nullptr, 0);
+            if (length <= 1) {
+                return "";
+            }
+            std::string uri(length, '\0');
+            FPDFAction_GetURIPath(document, action, uri.data(), length);
+            uri.resize(length - 1); // Drop the terminator
+            return uri;
+        }
+
+        void readLinkTarget(FPDF_DOCUMENT document, FPDF_LINK link, PageElementInfo& element) {
+            FPDF_DEST dest = FPDFLink_GetDest(document, link);
+            if (!dest) {
+                FPDF_ACTION action = FPDFLink_GetAction(link);
+                if (action) {
+                    unsigned long type = FPDFAction_GetType(action);
+                    if (type == PDFACTION_GOTO) {
+                        dest = FPDFAction_GetDest(document, action);
+                    } else if (type == PDFACTION_URI) {
+                        element.uri = getUriPath(document, action);
+                    }
+                }
+            }
+            if (dest) {
+                element.destPage = FPDFDest_GetDestPageIndex(document, dest);
+            }
+        }
+    }
+
+    PageElementIndex::PageElementIndex(FPDF_DOCUMENT document, FPDF_PAGE page) {
+        double pageHeight = FPDF_GetPageHeightF(page);
+        PageTransform transform(page);
+
+        // Links are annotations too. Walking the annotation list instead of FPDFLink_Enumerate
+        // gives links and other annotations in a single z-order.
+        int annotCount = FPDFPage_GetAnnotCount(page);
+        for (int i = 0; i < annotCount; i++) {
+            FPDF_ANNOTATION annot = FPDFPage_GetAnnot(page, i);
+            if (!annot) {
+                continue;
+            }
+            FPDF_ANNOTATION_SUBTYPE subtype = FPDFAnnot_GetSubtype(annot);
+            int flags = FPDFAnnot_GetFlags(annot);
+            FS_RECTF rect;
+            bool visible = subtype != FPDF_ANNOT_POPUP &&
+                           !(flags & (FPDF_ANNOT_FLAG_HIDDEN | FPDF_ANNOT_FLAG_NOVIEW));
+
+            if (visible && FPDFAnnot_GetRect(annot, &rect)) {
+                PageElementInfo element{subtype == FPDF_ANNOT_LINK, i, subtype, 0, 0, 0, 0, -1, ""};
+                transform.toDisplay(rect.left, rect.top, rect.right, rect.bottom,
+                                    element.left, element.top, element.right, element.bottom);
+                if (element.isLink) {
+                    FPDF_LINK link = FPDFAnnot_GetLink(annot);
+                    if (link) {
+                        readLinkTarget(document, link, element);
+                    }
+                }
+                m_elements.push_back(std::move(element));
+            }
+            FPDFPage_CloseAnnot(annot);
+        }
+
+        m_bandHeight = std::max(pageHeight, 1.0) / kBandCount;
+        m_bands.resize(kBandCount);
+        for (uint32_t i = 0; i < m_elements.size(); i++) {
+            int first = bandOf(m_elements[i].top), last = bandOf(m_elements[i].bottom);
+            for (int band = first; band <= last; band++) {
+                m_bands[band].push_back(i);
+            }
+        }
+    }
+
+    int PageElementIndex::bandOf(double y) const {
+        return std::clamp((int)std::floor(y / m_bandHeight), 0, kBandCount - 1);
+    }
+
+    const PageElementInfo* PageElementIndex::hitTest(double x, double y) const {
+        const std::vector<uint32_t>& band = m_bands[bandOf(y)];
+        // Later annotations are drawn on top, so search from the back
+        for (auto it = band.rbegin(); it != band.rend(); ++it) {
+            const PageElementInfo& element = m_elements[*it];
+            if (x >= element.left && x <= element.right && y >= element.top && y <= element.bottom) {
+                return &element;
+            }
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "fpdfview.h"
+
+namespace margelo::nitro::pdfium {
+
+    // A tappable element of a page. Bounds are page points with a top-left origin.
+    struct PageElementInfo {
+        bool isLink;
+        int annotIndex;
+        int subtype;       // FPDF_ANNOT_* subtype
+        float left;
+        float top;
+        float right;
+        float bottom;
+        int destPage;      // Target page of internal links, -1 otherwise
+        std::string uri;   // Target of URI actions, empty otherwise
+    };
+
+    // Links and annotations of a page, read once through fpdf_annot.h / fpdf_doc.h. Elements are
+    // bucketed into horizontal bands so a hit test only looks at the elements crossing the
+    // band of the point. Holds no PDFium handles, so it stays valid after the page is closed.
+    class PageElementIndex {
+        public:
+            PageElementIndex(FPDF_DOCUMENT document, FPDF_PAGE page);
+
+            // Topmost element containing the point, or nullptr
+            const PageElementInfo* hitTest(double x, double y) const;
+            const std::vector<PageElementInfo>& elements() const { return m_elements; }
+
+        private:
+            int bandOf(double y) const;
+
+            std::vector<PageElementInfo> m_elements; // In annotation (z) order, bottom first
+            double m_bandHeight = 1;
+            std::vector<std::vector<uint32_t>> m_bands;
+    };
+}
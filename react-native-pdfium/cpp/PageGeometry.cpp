@@ -0,0 +1,122 @@
+#include "PageGeometry.hpp"
+#include <algorithm>
+
+namespace margelo::nitro::pdfium {
+
+    void PageGeometry::reset(std::vector<float> widths, std::vector<float> heights) {
+        m_widths = std::move(widths);
+        m_heights = std::move(heights);
+        m_heights.resize(m_widths.size(), 0);
+        layout();
+    }
+
+    void PageGeometry::setLayout(LayoutMode mode, double pageGap, double spreadGap) {
+        m_mode = mode;
+        m_pageGap = std::max(pageGap, 0.0);
+        m_spreadGap = std::max(spreadGap, 0.0);
+        layout();
+    }
+
+    void PageGeometry::clear() {
+        m_widths.clear();
+        m_heights.clear();
+        m_bandStarts.clear();
+        m_maxBreadth = 0;
+    }
+
+    double PageGeometry::getBandLength(int band) const {
+        if (isHorizontal()) {
+            return m_widths[band];
+        }
+        int first = band * getPagesPerBand();
+        int last = std::min(first + getPagesPerBand(), getPageCount()) - 1;
+        return std::max(m_heights[first], m_heights[last]);
+    }
+
+    double PageGeometry::getBandBreadth(int band) const {
+        if (isHorizontal()) {
+            return m_heights[band];
+        }
+        int first = band * getPagesPerBand();
+        int last = std::min(first + getPagesPerBand(), getPageCount()) - 1;
+        return first == last ? m_widths[first] : m_widths[first] + m_spreadGap + m_widths[last];
+    }
+
+    void PageGeometry::layout() {
+        int bandCount = (getPageCount() + getPagesPerBand() - 1) / getPagesPerBand();
+        m_bandStarts.resize(bandCount + 1);
+        m_maxBreadth = 0;
+        double start = 0;
+        for (int band = 0; band < bandCount; band++) {
+            m_bandStarts[band] = start;
+            start += getBandLength(band) + m_pageGap;
+            m_maxBreadth = std::max(m_maxBreadth, getBandBreadth(band));
+        }
+        m_bandStarts[bandCount] = start;
+    }
+
+    double PageGeometry::getPageLeft(int pageIndex) const {
+        if (isHorizontal()) {
+            return m_bandStarts[pageIndex];
+        }
+        int band = pageIndex / getPagesPerBand();
+        double left = (m_maxBreadth - getBandBreadth(band)) / 2;
+        // The right page of a spread follows the left one
+        if (pageIndex % getPagesPerBand() != 0) {
+            left += m_widths[pageIndex - 1] + m_spreadGap;
+        }
+        return left;
+    }
+
+    double PageGeometry::getPageTop(int pageIndex) const {
+        if (isHorizontal()) {
+            return (m_maxBreadth - m_heights[pageIndex]) / 2;
+        }
+        return m_bandStarts[pageIndex / getPagesPerBand()];
+    }
+
+    double PageGeometry::getContentWidth() const {
+        if (m_widths.empty()) {
+            return 0;
+        }
+        return isHorizontal() ? m_bandStarts.back() - m_pageGap : m_maxBreadth;
+    }
+
+    double PageGeometry::getContentHeight() const {
+        if (m_widths.empty()) {
+            return 0;
+        }
+        return isHorizontal() ? m_maxBreadth : m_bandStarts.back() - m_pageGap;
+    }
+
+    double PageGeometry::getFitWidthScale(double viewportWidth) const {
+        double width = m_maxBreadth;
+        if (isHorizontal()) {
+            width = m_widths.empty() ? 0 : *std::max_element(m_widths.begin(), m_widths.end());
+        }
+        return width > 0 ? viewportWidth / width : 1;
+    }
+
+    bool PageGeometry::getPagesInRect(double left, double top, double right, double bottom, int& first, int& last) const {
+        int bandCount = getBandCount();
+        double start = isHorizontal() ? left : top;
+        double end = isHorizontal() ? right : bottom;
+        if (bandCount <= 0 || end <= start) {
+            return false;
+        }
+        // The last band starting at or before `start`, skipped if `start` is in the gap after it
+        int firstBand = (int)(std::upper_bound(m_bandStarts.begin(), m_bandStarts.begin() + bandCount, start) - m_bandStarts.begin()) - 1;
+        firstBand = std::max(firstBand, 0);
+        if (start >= m_bandStarts[firstBand] + getBandLength(firstBand)) {
+            firstBand++;
+        }
+        // The last band starting before `end`
+        int lastBand = (int)(std::lower_bound(m_bandStarts.begin(), m_bandStarts.begin() + bandCount, end) - m_bandStarts.begin()) - 1;
+        if (firstBand > lastBand || firstBand >= bandCount) {
+            return false;
+        }
+        first = firstBand * getPagesPerBand();
+        last = std::min((lastBand + 1) * getPagesPerBand(), getPageCount()) - 1;
+        return true;
+    }
+}
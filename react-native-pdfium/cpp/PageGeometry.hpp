@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include "LayoutMode.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // Continuous layout of the pages of a document, in page points. Pages are placed in bands
+    // along the scroll axis: one page per band top to bottom (vertical) or left to right
+    // (horizontal), or two facing pages per band top to bottom (spread). Bands are separated by
+    // the page gap and centered across the scroll axis, facing pages by the spread gap. Band
+    // starts are kept as prefix sums, so the pages in a range are found by binary search. Memory
+    // is a few bytes per page, whatever the mode.
+    class PageGeometry {
+        public:
+            void reset(std::vector<float> widths, std::vector<float> heights);
+            void setLayout(LayoutMode mode, double pageGap, double spreadGap);
+            void clear();
+
+            int getPageCount() const { return (int)m_widths.size(); }
+            double getPageWidth(int pageIndex) const { return m_widths[pageIndex]; }
+            double getPageHeight(int pageIndex) const { return m_heights[pageIndex]; }
+            double getPageLeft(int pageIndex) const;
+            double getPageTop(int pageIndex) const;
+            LayoutMode getMode() const { return m_mode; }
+            double getPageGap() const { return m_pageGap; }
+            double getSpreadGap() const { return m_spreadGap; }
+            double getContentWidth() const;
+            double getContentHeight() const;
+            // Scale at which the widest band fills the viewport width
+            double getFitWidthScale(double viewportWidth) const;
+
+            // First and last page of the bands intersecting the rect along the scroll axis.
+            // Returns false if the rect only covers gaps or lies outside the document. Pages in
+            // the range may still miss the rect across the scroll axis.
+            bool getPagesInRect(double left, double top, double right, double bottom, int& first, int& last) const;
+
+        private:
+            bool isHorizontal() const { return m_mode == LayoutMode::HORIZONTAL; }
+            int getPagesPerBand() const { return m_mode == LayoutMode::SPREAD ? 2 : 1; }
+            int getBandCount() const { return (int)m_bandStarts.size() - 1; }
+            // Extent of a band along and across the scroll axis
+            double getBandLength(int band) const;
+            double getBandBreadth(int band) const;
+            void layout();
+
+            std::vector<float> m_widths;
+            std::vector<float> m_heights;
+            std::vector<double> m_bandStarts; // One entry per band plus the end of the last gap
+            LayoutMode m_mode = LayoutMode::VERTICAL;
+            double m_pageGap = 0;
+            double m_spreadGap = 0;
+            double m_maxBreadth = 0;
+    };
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace margelo::nitro::pdfium {
+
+    // FPDFPageObj_GetBounds leaves out antialiasing and, for some paths, half the stroke width.
+    // Maps of where page objects draw widen their bounds by this many points.
+    inline constexpr double kObjectBoundsMargin = 2;
+}
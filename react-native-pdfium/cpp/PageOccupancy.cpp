@@ -0,0 +1,84 @@
+#include "PageOccupancy.hpp"
+#include "PageObjectBounds.hpp"
+#include "fpdf_edit.h"
+#include <algorithm>
+#include <cmath>
+
+namespace margelo::nitro::pdfium {
+
+    static constexpr int kGridSize = 64;
+
+    PageOccupancy::PageOccupancy(FPDF_PAGE page) : m_cells(kGridSize * kGridSize, 0) {
+        double pageWidth = FPDF_GetPageWidthF(page);
+        double pageHeight = FPDF_GetPageHeightF(page);
+        m_cellWidth = std::max(pageWidth, 1.0) / kGridSize;
+        m_cellHeight = std::max(pageHeight, 1.0) / kGridSize;
+
+        // Object bounds are in PDF user space. Only unrotated pages map onto the rendered page
+        // by a plain translation from the crop box.
+        FS_RECTF box;
+        if (FPDFPage_GetRotation(page) != 0 || !FPDF_GetPageBoundingBox(page, &box)) {
+            m_full = true;
+            return;
+        }
+
+        int objectCount = FPDFPage_CountObjects(page);
+        for (int i = 0; i < objectCount; i++) {
+            FPDF_PAGEOBJECT object = FPDFPage_GetObject(page, i);
+            float left, bottom, right, top;
+            if (!object || !FPDFPageObj_GetBounds(object, &left, &bottom, &right, &top)) {
+                // Content of unknown extent could be anywhere, culling around it could blank it
+                m_full = true;
+                return;
+            }
+            mark(left - box.left - kObjectBoundsMargin, box.top - top - kObjectBoundsMargin,
+                 right - box.left + kObjectBoundsMargin, box.top - bottom + kObjectBoundsMargin);
+        }
+    }
+
+    void PageOccupancy::mark(double left, double top, double right, double bottom) {
+        if (right < 0 || bottom < 0 || left > m_cellWidth * kGridSize || top > m_cellHeight * kGridSize) {
+            return; // Entirely off the page
+        }
+        int firstColumn = std::clamp((int)std::floor(left / m_cellWidth), 0, kGridSize - 1);
+        int lastColumn = std::clamp((int)std::floor(right / m_cellWidth), 0, kGridSize - 1);
+        int firstRow = std::clamp((int)std::floor(top / m_cellHeight), 0, kGridSize - 1);
+        int lastRow = std::clamp((int)std::floor(bottom / m_cellHeight), 0, kGridSize - 1);
+        for (int row = firstRow; row <= lastRow; row++) {
+            std::fill(m_cells.begin() + row * kGridSize + firstColumn,
+                      m_cells.begin() + row * kGridSize + lastColumn + 1, 1);
+        }
+    }
+
+    bool PageOccupancy::contentIn(const PageRect& rect, PageRect& content) const {
+        if (m_full) {
+            content = rect;
+            return true;
+        }
+        int firstColumn = std::clamp((int)std::floor(rect.left / m_cellWidth), 0, kGridSize - 1);
+        int lastColumn = std::clamp((int)std::floor(rect.right / m_cellWidth), 0, kGridSize - 1);
+        int firstRow = std::clamp((int)std::floor(rect.top / m_cellHeight), 0, kGridSize - 1);
+        int lastRow = std::clamp((int)std::floor(rect.bottom / m_cellHeight), 0, kGridSize - 1);
+
+        int minColumn = kGridSize, maxColumn = -1, minRow = kGridSize, maxRow = -1;
+        for (int row = firstRow; row <= lastRow; row++) {
+            const uint8_t* cells = m_cells.data() + row * kGridSize;
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                if (cells[column]) {
+                    minColumn = std::min(minColumn, column);
+                    maxColumn = std::max(maxColumn, column);
+                    minRow = std::min(minRow, row);
+                    maxRow = row;
+                }
+            }
+        }
+        if (maxRow < 0) {
+            return false;
+        }
+        content.left = std::max(rect.left, minColumn * m_cellWidth);
+        content.top = std::max(rect.top, minRow * m_cellHeight);
+        content.right = std::min(rect.right, (maxColumn + 1) * m_cellWidth);
+        content.bottom = std::min(rect.bottom, (maxRow + 1) * m_cellHeight);
+        return content.left < content.right && content.top < content.bottom;
+    }
+}
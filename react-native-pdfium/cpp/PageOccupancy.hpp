@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "fpdfview.h"
+
+namespace margelo::nitro::pdfium {
+
+    // A rectangle in page points with a top-left origin
+    struct PageRect {
+        double left;
+        double top;
+        double right;
+        double bottom;
+    };
+
+    // Coarse map of where a page has content, built once from the bounds of its page objects
+    // (fpdf_edit.h). Tiles over empty cells can skip rasterization, and tiles over partly
+    // empty ones can clip rendering to the occupied cells. Holds no PDFium handles.
+    class PageOccupancy {
+        public:
+            explicit PageOccupancy(FPDF_PAGE page);
+
+            // Bounds of the occupied cells within the rect, clamped to the rect. Returns false
+            // if the rect holds no content.
+            bool contentIn(const PageRect& rect, PageRect& content) const;
+
+        private:
+            void mark(double left, double top, double right, double bottom);
+
+            double m_cellWidth = 1;
+            double m_cellHeight = 1;
+            // Pages the map can not describe (rotated pages, objects without bounds) are treated
+            // as fully occupied
+            bool m_full = false;
+            std::vector<uint8_t> m_cells; // Row major, 1 if any object touches the cell
+    };
+}
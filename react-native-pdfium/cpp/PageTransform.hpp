@@ -0,0 +1,60 @@
+#pragma once
+#include <algorithm>
+#include "fpdfview.h"
+#include "fpdf_edit.h"
+
+namespace margelo::nitro::pdfium {
+
+    // Maps PDF user space (bottom-left origin, unrotated, as reported for characters, annotations
+    // and objects) to the page as displayed: top-left origin, relative to the crop box and turned
+    // by the page rotation, the same placement FPDF_PageToDevice gives the rendered page.
+    class PageTransform {
+        public:
+            PageTransform() = default;
+            explicit PageTransform(FPDF_PAGE page) {
+                FS_RECTF box;
+                if (FPDF_GetPageBoundingBox(page, &box)) {
+                    m_left = box.left;
+                    m_top = box.top;
+                    m_width = box.right - box.left;
+                    m_height = box.top - box.bottom;
+                } else {
+                    m_width = FPDF_GetPageWidthF(page);
+                    m_height = FPDF_GetPageHeightF(page);
+                    m_top = m_height;
+                }
+                m_rotation = ((FPDFPage_GetRotation(page) % 4) + 4) % 4; // Clockwise quarter turns
+            }
+
+            void toDisplay(double x, double y, double& displayX, double& displayY) const {
+                // Unrotated, top-left origin within the crop box
+                double ux = x - m_left;
+                double uy = m_top - y;
+                switch (m_rotation) {
+                    case 1: displayX = m_height - uy; displayY = ux; break;
+                    case 2: displayX = m_width - ux; displayY = m_height - uy; break;
+                    case 3: displayX = uy; displayY = m_width - ux; break;
+                    default: displayX = ux; displayY = uy; break;
+                }
+            }
+
+            // Maps a PDF space rect given by two corners to display space
+            void toDisplay(double left, double top, double right, double bottom,
+                           float& displayLeft, float& displayTop, float& displayRight, float& displayBottom) const {
+                double x0, y0, x1, y1;
+                toDisplay(left, top, x0, y0);
+                toDisplay(right, bottom, x1, y1);
+                displayLeft = (float)std::min(x0, x1);
+                displayTop = (float)std::min(y0, y1);
+                displayRight = (float)std::max(x0, x1);
+                displayBottom = (float)std::max(y0, y1);
+            }
+
+        private:
+            double m_left = 0;
+            double m_top = 0;
+            double m_width = 0;  // Crop box size before rotation
+            double m_height = 0;
+            int m_rotation = 0;
+    };
+}
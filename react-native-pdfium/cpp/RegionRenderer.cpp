@@ -0,0 +1,168 @@
+#include "RegionRenderer.hpp"
+#include "PageObjectBounds.hpp"
+#include "fpdf_edit.h"
+#include "fpdf_ppo.h"
+#include <algorithm>
+#include <cmath>
+
+namespace margelo::nitro::pdfium {
+
+    static constexpr int kRegionsPerSide = 8;
+    // Pages with fewer objects render fast enough on their own
+    static constexpr int kLargePageObjects = 2000;
+    // Beyond this many regions per tile the sub-page renders cost more than they save
+    static constexpr int kMaxRegionsPerRender = 4;
+    static constexpr size_t kMaxRegionPages = 32;
+
+    RegionRenderer::RegionRenderer() : m_regionPages(kMaxRegionPages) {
+        m_regionPages.setEvictionListener([](const int64_t&, const RegionPage& region, EvictionReason) {
+            FPDF_ClosePage(region.page);
+            FPDF_CloseDocument(region.document);
+        });
+    }
+
+    const RegionRenderer::PageRegions& RegionRenderer::getRegions(FPDF_PAGE page, int pageIndex) {
+        auto it = m_pageRegions.find(pageIndex);
+        if (it != m_pageRegions.end()) {
+            return it->second;
+        }
+        PageRegions& regions = m_pageRegions[pageIndex];
+
+        // Regions are laid out in PDF user space, which only matches the rendered page by a
+        // translation on unrotated pages
+        int objectCount = FPDFPage_CountObjects(page);
+        if (objectCount < kLargePageObjects || FPDFPage_GetRotation(page) != 0 ||
+            !FPDF_GetPageBoundingBox(page, &regions.box)) {
+            return regions;
+        }
+        regions.large = true;
+        regions.regionWidth = std::max(regions.box.right - regions.box.left, 1.0f) / kRegionsPerSide;
+        regions.regionHeight = std::max(regions.box.top - regions.box.bottom, 1.0f) / kRegionsPerSide;
+        regions.objectCounts.assign(kRegionsPerSide * kRegionsPerSide, 0);
+
+        for (int i = 0; i < objectCount; i++) {
+            FPDF_PAGEOBJECT object = FPDFPage_GetObject(page, i);
+            float left, bottom, right, top;
+            if (!object || !FPDFPageObj_GetBounds(object, &left, &bottom, &right, &top)) {
+                continue;
+            }
+            int firstColumn = std::clamp((int)std::floor((left - kObjectBoundsMargin - regions.box.left) / regions.regionWidth), 0, kRegionsPerSide - 1);
+            int lastColumn = std::clamp((int)std::floor((right + kObjectBoundsMargin - regions.box.left) / regions.regionWidth), 0, kRegionsPerSide - 1);
+            int firstRow = std::clamp((int)std::floor((regions.box.top - top - kObjectBoundsMargin) / regions.regionHeight), 0, kRegionsPerSide - 1);
+            int lastRow = std::clamp((int)std::floor((regions.box.top - bottom + kObjectBoundsMargin) / regions.regionHeight), 0, kRegionsPerSide - 1);
+            for (int row = firstRow; row <= lastRow; row++) {
+                for (int column = firstColumn; column <= lastColumn; column++) {
+                    regions.objectCounts[row * kRegionsPerSide + column]++;
+                }
+            }
+        }
+        return regions;
+    }
+
+    FPDF_PAGE RegionRenderer::getRegionPage(FPDF_DOCUMENT document, int pageIndex, int region, const PageRegions& regions) {
+        int64_t key = (int64_t)pageIndex * kRegionsPerSide * kRegionsPerSide + region;
+        std::optional<RegionPage> cached = m_regionPages.get(key);
+        if (cached) {
+            return cached->page;
+        }
+
+        FPDF_DOCUMENT regionDocument = FPDF_CreateNewDocument();
+        if (!regionDocument) {
+            return nullptr;
+        }
+        FPDF_PAGE regionPage = nullptr;
+        if (FPDF_ImportPagesByIndex(regionDocument, document, &pageIndex, 1, 0)) {
+            regionPage = FPDF_LoadPage(regionDocument, 0);
+        }
+        if (!regionPage) {
+            FPDF_CloseDocument(regionDocument);
+            return nullptr;
+        }
+
+        // Region bounds in PDF user space, widened so objects reaching in by their margin stay
+        float regionLeft = regions.box.left + (region % kRegionsPerSide) * regions.regionWidth - kObjectBoundsMargin;
+        float regionRight = regionLeft + regions.regionWidth + 2 * kObjectBoundsMargin;
+        float regionTop = regions.box.top - (region / kRegionsPerSide) * regions.regionHeight + kObjectBoundsMargin;
+        float regionBottom = regionTop - regions.regionHeight - 2 * kObjectBoundsMargin;
+
+        // Removing from the back keeps the indices of the remaining objects stable
+        for (int i = FPDFPage_CountObjects(regionPage) - 1; i >= 0; i--) {
+            FPDF_PAGEOBJECT object = FPDFPage_GetObject(regionPage, i);
+            float left, bottom, right, top;
+            if (!object || !FPDFPageObj_GetBounds(object, &left, &bottom, &right, &top)) {
+                continue;
+            }
+            if (right < regionLeft || left > regionRight || top < regionBottom || bottom > regionTop) {
+                if (FPDFPage_RemoveObject(regionPage, object)) {
+                    FPDFPageObj_Destroy(object);
+                }
+            }
+        }
+        FPDFPage_GenerateContent(regionPage);
+
+        m_regionPages.put(key, RegionPage{regionDocument, regionPage});
+        return regionPage;
+    }
+
+    bool RegionRenderer::render(FPDF_DOCUMENT document, FPDF_PAGE page, int pageIndex, FPDF_BITMAP bitmap,
+                                const FS_MATRIX& matrix, const FS_RECTF& clip, int flags) {
+        const PageRegions& regions = getRegions(page, pageIndex);
+        if (!regions.large || matrix.a <= 0 || matrix.d <= 0) {
+            return false;
+        }
+
+        // Regions under the clip, in page points with a top-left origin
+        auto toColumn = [&](double x) {
+            return std::clamp((int)std::floor((x - matrix.e) / matrix.a / regions.regionWidth), 0, kRegionsPerSide - 1);
+        };
+        auto toRow = [&](double y) {
+            return std::clamp((int)std::floor((y - matrix.f) / matrix.d / regions.regionHeight), 0, kRegionsPerSide - 1);
+        };
+        int firstColumn = toColumn(clip.left), lastColumn = toColumn(clip.right - 1);
+        int firstRow = toRow(clip.top), lastRow = toRow(clip.bottom - 1);
+        if ((lastColumn - firstColumn + 1) * (lastRow - firstRow + 1) > kMaxRegionsPerRender) {
+            return false;
+        }
+
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                int region = row * kRegionsPerSide + column;
+                if (regions.objectCounts[region] == 0) {
+                    continue;
+                }
+                // Region edges are snapped to whole pixels so neighbouring regions neither overlap
+                // nor leave seams
+                FS_RECTF regionClip = {
+                    std::max(clip.left, std::round((float)(column * regions.regionWidth * matrix.a + matrix.e))),
+                    std::max(clip.top, std::round((float)(row * regions.regionHeight * matrix.d + matrix.f))),
+                    std::min(clip.right, std::round((float)((column + 1) * regions.regionWidth * matrix.a + matrix.e))),
+                    std::min(clip.bottom, std::round((float)((row + 1) * regions.regionHeight * matrix.d + matrix.f)))
+                };
+                // Edge regions extend to the clip so nothing past the page grid is dropped
+                if (column == 0) regionClip.left = clip.left;
+                if (row == 0) regionClip.top = clip.top;
+                if (column == kRegionsPerSide - 1) regionClip.right = clip.right;
+                if (row == kRegionsPerSide - 1) regionClip.bottom = clip.bottom;
+                if (regionClip.left >= regionClip.right || regionClip.top >= regionClip.bottom) {
+                    continue;
+                }
+
+                FPDF_PAGE regionPage = getRegionPage(document, pageIndex, region, regions);
+                FPDF_RenderPageBitmapWithMatrix(bitmap, regionPage ? regionPage : page, &matrix, &regionClip, flags);
+            }
+        }
+        return true;
+    }
+
+    void RegionRenderer::evictPage(int pageIndex) {
+        m_pageRegions.erase(pageIndex);
+        for (int region = 0; region < kRegionsPerSide * kRegionsPerSide; region++) {
+            m_regionPages.erase((int64_t)pageIndex * kRegionsPerSide * kRegionsPerSide + region);
+        }
+    }
+
+    void RegionRenderer::clear() {
+        m_pageRegions.clear();
+        m_regionPages.clear();
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "fpdfview.h"
+#include "TileCache.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // Renders pages with very many objects, such as CAD drawings, from per-region sub-pages.
+    // Each sub-page is a copy of the page (fpdf_ppo.h) stripped of the objects that do not
+    // touch its region (fpdf_edit.h), so a tile at high zoom only walks the objects around it
+    // instead of the whole content stream. Sub-pages are built on first use and kept in an LRU.
+    class RegionRenderer {
+        public:
+            RegionRenderer();
+            RegionRenderer(const RegionRenderer&) = delete;
+            RegionRenderer& operator=(const RegionRenderer&) = delete;
+            ~RegionRenderer() { clear(); }
+
+            // Renders the clip of the page through its region sub-pages. The matrix must be a
+            // plain scale and translation. Returns false, without drawing, if the page is not
+            // large or the clip spans too many regions to benefit; the caller then renders
+            // the page itself.
+            bool render(FPDF_DOCUMENT document, FPDF_PAGE page, int pageIndex, FPDF_BITMAP bitmap,
+                        const FS_MATRIX& matrix, const FS_RECTF& clip, int flags);
+
+            void evictPage(int pageIndex);
+            void clear();
+
+        private:
+            // Spatial histogram of the page objects over a grid of regions
+            struct PageRegions {
+                bool large = false;
+                double regionWidth = 1;
+                double regionHeight = 1;
+                FS_RECTF box{};                // Crop box in PDF user space
+                std::vector<int> objectCounts; // Objects touching each region, row major
+            };
+
+            struct RegionPage {
+                FPDF_DOCUMENT document;
+                FPDF_PAGE page;
+            };
+
+            const PageRegions& getRegions(FPDF_PAGE page, int pageIndex);
+            FPDF_PAGE getRegionPage(FPDF_DOCUMENT document, int pageIndex, int region, const PageRegions& regions);
+
+            std::unordered_map<int, PageRegions> m_pageRegions;
+            LRUCache<int64_t, RegionPage> m_regionPages;
+    };
+}
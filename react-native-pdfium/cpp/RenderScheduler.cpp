@@ -0,0 +1,146 @@
+#include "RenderScheduler.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace margelo::nitro::pdfium {
+
+    // Weight of the latest render in the expected render time
+    static constexpr double kRenderTimeSmoothing = 0.2;
+
+    int RenderScheduler::schedule(const TileRequest& request, RenderPriority priority, double deadlineMs,
+                                  int documentId, Callback callback) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        int id = m_nextId++;
+        Clock::time_point now = Clock::now();
+        std::optional<Clock::time_point> deadline;
+        if (deadlineMs > 0) {
+            deadline = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(deadlineMs));
+        }
+        m_jobs.emplace(id, Job{id, request, priority, deadline, now, documentId, std::move(callback)});
+        m_queue.insert(Order{(int)priority, deadline.value_or(Clock::time_point::max()), id});
+
+        if (!m_thread.joinable()) {
+            m_stopRequested = false;
+            m_thread = std::thread(&RenderScheduler::run, this);
+        }
+        m_condition.notify_one();
+        return id;
+    }
+
+    bool RenderScheduler::cancel(int id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_jobs.find(id);
+        if (it == m_jobs.end()) {
+            return false;
+        }
+        const Job& job = it->second;
+        m_queue.erase(Order{(int)job.priority, job.deadline.value_or(Clock::time_point::max()), id});
+        m_jobs.erase(it);
+        m_stats.dropped++;
+        return true;
+    }
+
+    void RenderScheduler::cancelAll() {
+        std::vector<Job> jobs;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& [id, job] : m_jobs) {
+                jobs.push_back(std::move(job));
+            }
+            m_stats.dropped += (int)m_jobs.size();
+            m_jobs.clear();
+            m_queue.clear();
+        }
+        for (const Job& job : jobs) {
+            job.callback(job.id, job.request, std::nullopt);
+        }
+    }
+
+    void RenderScheduler::stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.clear();
+            m_queue.clear();
+            m_stopRequested = true;
+        }
+        m_condition.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    RenderSchedulerStatsData RenderScheduler::getStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        RenderSchedulerStatsData stats = m_stats;
+        stats.queueDepth = (int)m_queue.size();
+        stats.visibleQueueDepth = (int)std::count_if(m_queue.begin(), m_queue.end(), [](const Order& order) {
+            return order.priority == (int)RenderPriority::VISIBLE;
+        });
+        stats.averageWaitMs = m_started > 0 ? m_totalWaitMs / m_started : 0;
+        stats.averageVisibleWaitMs = m_visibleStarted > 0 ? m_totalVisibleWaitMs / m_visibleStarted : 0;
+        return stats;
+    }
+
+    void RenderScheduler::run() {
+        while (true) {
+            std::optional<Job> job;
+            bool dropped = false;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopRequested || !m_queue.empty(); });
+                if (m_stopRequested) {
+                    return;
+                }
+                auto next = m_jobs.find(m_queue.begin()->id);
+                job.emplace(std::move(next->second));
+                m_jobs.erase(next);
+                m_queue.erase(m_queue.begin());
+
+                Clock::time_point now = Clock::now();
+                double waitMs = std::chrono::duration<double, std::milli>(now - job->scheduled).count();
+                m_started++;
+                m_totalWaitMs += waitMs;
+                m_stats.maxWaitMs = std::max(m_stats.maxWaitMs, waitMs);
+                bool visible = job->priority == RenderPriority::VISIBLE;
+                if (visible) {
+                    m_visibleStarted++;
+                    m_totalVisibleWaitMs += waitMs;
+                }
+
+                // A render expected to finish late is still worth a draft if it is on screen
+                auto expectedEnd = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(m_expectedRenderMs));
+                if (job->deadline && expectedEnd > *job->deadline) {
+                    if (!visible) {
+                        dropped = true;
+                        m_stats.dropped++;
+                    } else if (job->request.quality.value_or(TileQuality::FULL) == TileQuality::FULL) {
+                        job->request.quality = TileQuality::DRAFT;
+                        m_stats.downgraded++;
+                    }
+                }
+            }
+            if (dropped) {
+                job->callback(job->id, job->request, std::nullopt);
+                continue;
+            }
+
+            double renderMs = -1;
+            std::optional<RenderedTile> tile = m_renderer(job->request, job->documentId, renderMs);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                // Cache hits take next to no time and would make every deadline look safe
+                if (tile && renderMs >= 0) {
+                    m_expectedRenderMs = m_rasterized++ == 0
+                        ? renderMs
+                        : m_expectedRenderMs + (renderMs - m_expectedRenderMs) * kRenderTimeSmoothing;
+                }
+                if (tile) {
+                    m_stats.completed++;
+                } else {
+                    m_stats.dropped++;
+                }
+            }
+            job->callback(job->id, job->request, tile);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include "RenderPriority.hpp"
+#include "RenderedTile.hpp"
+#include "TileRequest.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    struct RenderSchedulerStatsData {
+        int queueDepth = 0;
+        int visibleQueueDepth = 0;
+        int completed = 0;
+        int dropped = 0;           // Background renders past their deadline, or cancelled
+        int downgraded = 0;        // Visible renders turned into drafts to meet their deadline
+        double averageWaitMs = 0;  // Time from schedule to the start of the render
+        double maxWaitMs = 0;
+        double averageVisibleWaitMs = 0;
+    };
+
+    // Runs scheduled renders on a worker thread, highest priority class first and earliest
+    // deadline first within a class. Renders are short tiles, so visible work queued behind
+    // background work waits for one tile at most. A render that cannot start in time is
+    // downgraded to a draft if it is visible and dropped otherwise.
+    class RenderScheduler {
+        public:
+            // Renders the tile, or returns nothing if the document it was scheduled for is no
+            // longer open. Sets renderMs to the time spent rasterizing, negative if the tile came
+            // from a cache. Called on the worker thread.
+            using Renderer = std::function<std::optional<RenderedTile>(const TileRequest& request, int documentId, double& renderMs)>;
+            // Receives the id and request of the render, and the tile or nothing if it was dropped
+            using Callback = std::function<void(int id, const TileRequest& request, const std::optional<RenderedTile>& tile)>;
+
+            explicit RenderScheduler(Renderer renderer) : m_renderer(std::move(renderer)) {}
+            ~RenderScheduler() { stop(); }
+
+            // Queues a render and returns its id. deadlineMs is relative to now, 0 for none.
+            int schedule(const TileRequest& request, RenderPriority priority, double deadlineMs,
+                         int documentId, Callback callback);
+            // Drops a queued render without calling back. Returns false if it already started.
+            bool cancel(int id);
+            // Drops every queued render, calling back with nothing
+            void cancelAll();
+            void stop();
+            RenderSchedulerStatsData getStats();
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct Job {
+                int id;
+                TileRequest request;
+                RenderPriority priority;
+                std::optional<Clock::time_point> deadline;
+                Clock::time_point scheduled;
+                int documentId;
+                Callback callback;
+            };
+
+            // Queue order: priority class, then deadline (none last), then arrival
+            struct Order {
+                int priority;
+                Clock::time_point deadline;
+                int id;
+
+                bool operator<(const Order& other) const {
+                    if (priority != other.priority) {
+                        return priority < other.priority;
+                    }
+                    if (deadline != other.deadline) {
+                        return deadline < other.deadline;
+                    }
+                    return id < other.id;
+                }
+            };
+
+            void run();
+
+            Renderer m_renderer;
+            std::thread m_thread;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::set<Order> m_queue;
+            std::unordered_map<int, Job> m_jobs; // Queued jobs by id
+            int m_nextId = 1;
+            bool m_stopRequested = false;
+            double m_expectedRenderMs = 0; // Moving average of rasterizations, predicts missed deadlines
+            int m_rasterized = 0;
+            double m_totalWaitMs = 0;
+            double m_totalVisibleWaitMs = 0;
+            int m_started = 0;
+            int m_visibleStarted = 0;
+            RenderSchedulerStatsData m_stats;
+    };
+}
@@ -0,0 +1,196 @@
+#include "TextIndex.hpp"
+#include "TextUtils.hpp"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+namespace margelo::nitro::pdfium {
+
+    void TextIndex::start(int pageCount, PageTextLoader loader) {
+        stop();
+
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            m_pageTokens.assign(pageCount, {});
+        }
+        m_pageIndexed.assign(pageCount, false);
+        m_loader = std::move(loader);
+        m_stopRequested.store(false);
+        m_running.store(true);
+        m_thread = std::thread(&TextIndex::run, this);
+    }
+
+    void TextIndex::stop() {
+        m_stopRequested.store(true);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        m_running.store(false);
+        m_indexedPageCount.store(0);
+        m_pageIndexed.clear();
+        m_loader = nullptr;
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_termIds.clear();
+        m_postings.clear();
+        m_unsortedTerms.clear();
+        m_pageTokens.clear();
+    }
+
+    int TextIndex::nextPageToIndex() {
+        // Walk outwards from the focus page until an unindexed page is found
+        int pageCount = (int)m_pageIndexed.size();
+        int focus = std::clamp(m_focusPage.load(), 0, std::max(pageCount - 1, 0));
+        for (int distance = 0; distance < pageCount; distance++) {
+            int after = focus + distance;
+            if (after < pageCount && !m_pageIndexed[after]) {
+                return after;
+            }
+            int before = focus - distance;
+            if (before >= 0 && !m_pageIndexed[before]) {
+                return before;
+            }
+        }
+        return -1;
+    }
+
+    void TextIndex::run() {
+        std::u16string text;
+        while (!m_stopRequested.load()) {
+            int pageIndex = nextPageToIndex();
+            if (pageIndex < 0) {
+                break;
+            }
+
+            text.clear();
+            if (m_loader(pageIndex, text)) {
+                addPage(pageIndex, text);
+            } else {
+                std::cerr << "Failed to load text of page " << pageIndex << " for indexing." << std::endl;
+            }
+            m_pageIndexed[pageIndex] = true;
+            m_indexedPageCount.fetch_add(1);
+
+            // The loader holds the document lock only for a single page, give rendering a
+            // chance to run before indexing the next one
+            std::this_thread::yield();
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            sortAllPostings();
+        }
+        m_running.store(false);
+    }
+
+    void TextIndex::addPage(int pageIndex, const std::u16string& text) {
+        std::vector<TextToken> tokens = tokenizeText(text);
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        std::vector<PageToken>& pageTokens = m_pageTokens[pageIndex];
+        pageTokens.reserve(tokens.size());
+
+        for (const TextToken& token : tokens) {
+            auto it = m_termIds.find(token.term);
+            uint32_t termId;
+            if (it == m_termIds.end()) {
+                termId = (uint32_t)m_postings.size();
+                m_termIds.emplace(token.term, termId);
+                m_postings.emplace_back();
+            } else {
+                termId = it->second;
+            }
+
+            // Pages are indexed outwards from the focus page, so postings are appended and the
+            // lists put back in page order once, when indexing ends or a search needs them
+            std::vector<Posting>& postings = m_postings[termId];
+            if (!postings.empty() && postings.back().page > (uint32_t)pageIndex) {
+                m_unsortedTerms.insert(termId);
+            }
+            postings.push_back({(uint32_t)pageIndex, (uint32_t)pageTokens.size()});
+
+            pageTokens.push_back({termId, (uint32_t)token.charStart, (uint32_t)token.charCount});
+        }
+    }
+
+    void TextIndex::sortPostings(uint32_t termId) const {
+        if (m_unsortedTerms.erase(termId) == 0) {
+            return;
+        }
+        // Postings of one page are appended together in token order, a stable sort by page keeps it
+        std::vector<Posting>& postings = m_postings[termId];
+        std::stable_sort(postings.begin(), postings.end(), [](const Posting& a, const Posting& b) { return a.page < b.page; });
+    }
+
+    void TextIndex::sortAllPostings() {
+        while (!m_unsortedTerms.empty()) {
+            sortPostings(*m_unsortedTerms.begin());
+        }
+    }
+
+    std::vector<TextIndexHit> TextIndex::search(const std::string& query, size_t maxResults) const {
+        std::vector<TextIndexHit> hits;
+        std::vector<TextToken> queryTokens = tokenizeText(utf8ToUtf16(query));
+        if (queryTokens.empty() || maxResults == 0) {
+            return hits;
+        }
+
+        {
+            // Searches during indexing sort the lists they read
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+            for (const TextToken& token : queryTokens) {
+                auto it = m_termIds.find(token.term);
+                if (it != m_termIds.end()) {
+                    sortPostings(it->second);
+                }
+            }
+        }
+
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        std::vector<uint32_t> termIds;
+        termIds.reserve(queryTokens.size());
+        for (const TextToken& token : queryTokens) {
+            auto it = m_termIds.find(token.term);
+            if (it == m_termIds.end()) {
+                return hits; // A word that never occurs can not be part of a phrase match
+            }
+            termIds.push_back(it->second);
+        }
+
+        // Drive the phrase match from the rarest word to touch as few postings as possible
+        size_t anchor = 0;
+        for (size_t i = 1; i < termIds.size(); i++) {
+            if (m_postings[termIds[i]].size() < m_postings[termIds[anchor]].size()) {
+                anchor = i;
+            }
+        }
+
+        for (const Posting& posting : m_postings[termIds[anchor]]) {
+            if (posting.tokenIndex < anchor) {
+                continue;
+            }
+            const std::vector<PageToken>& pageTokens = m_pageTokens[posting.page];
+            uint32_t first = posting.tokenIndex - (uint32_t)anchor;
+            uint32_t last = first + (uint32_t)termIds.size() - 1;
+            if (last >= pageTokens.size()) {
+                continue;
+            }
+
+            bool matches = true;
+            for (size_t i = 0; i < termIds.size() && matches; i++) {
+                matches = pageTokens[first + i].termId == termIds[i];
+            }
+            if (!matches) {
+                continue;
+            }
+
+            int charIndex = (int)pageTokens[first].charStart;
+            int charEnd = (int)(pageTokens[last].charStart + pageTokens[last].charCount);
+            hits.push_back({(int)posting.page, charIndex, charEnd - charIndex});
+            if (hits.size() >= maxResults) {
+                break;
+            }
+        }
+        return hits;
+    }
+}
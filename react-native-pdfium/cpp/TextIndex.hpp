@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace margelo::nitro::pdfium {
+
+    // A match in the document. Character indices refer to the PDFium text page of `page`.
+    struct TextIndexHit {
+        int page;
+        int charIndex;
+        int charCount;
+    };
+
+    // Inverted index over the normalized words of every page. The index is built on a
+    // background thread and can be queried while it is still being filled; pages that are
+    // not indexed yet simply do not contribute hits.
+    class TextIndex {
+        public:
+            // Loads the UTF-16 text of a page. Returns false if the page could not be read.
+            using PageTextLoader = std::function<bool(int pageIndex, std::u16string& text)>;
+
+            TextIndex() = default;
+            ~TextIndex() { stop(); }
+
+            // Starts indexing `pageCount` pages. Pages closest to the page set through
+            // setFocusPage are indexed first, so what the user is reading becomes searchable
+            // before the rest of the document.
+            void start(int pageCount, PageTextLoader loader);
+            // Stops the indexing thread and drops everything that was indexed.
+            void stop();
+
+            void setFocusPage(int pageIndex) { m_focusPage.store(pageIndex); }
+            int getIndexedPageCount() const { return m_indexedPageCount.load(); }
+            bool isRunning() const { return m_running.load(); }
+
+            // Finds pages containing all words of `query` as a phrase. Words are matched
+            // whole and case-insensitively. Results are ordered by page and position.
+            std::vector<TextIndexHit> search(const std::string& query, size_t maxResults) const;
+
+        private:
+            struct PageToken {
+                uint32_t termId;
+                uint32_t charStart;
+                uint32_t charCount;
+            };
+
+            struct Posting {
+                uint32_t page;
+                uint32_t tokenIndex;
+            };
+
+            void run();
+            int nextPageToIndex();
+            void addPage(int pageIndex, const std::u16string& text);
+            // Restores page order in posting lists that pages indexed out of order appended to.
+            // The caller holds the unique lock.
+            void sortPostings(uint32_t termId) const;
+            void sortAllPostings();
+
+            PageTextLoader m_loader;
+            std::thread m_thread;
+            std::atomic<bool> m_running{false};
+            std::atomic<bool> m_stopRequested{false};
+            std::atomic<int> m_focusPage{0};
+            std::atomic<int> m_indexedPageCount{0};
+            std::vector<bool> m_pageIndexed;
+
+            mutable std::shared_mutex m_mutex; // Guards the index data below.
+            std::unordered_map<std::string, uint32_t> m_termIds;
+            // Indexed by term id. Mutable since search sorts the lists it reads.
+            mutable std::vector<std::vector<Posting>> m_postings;
+            mutable std::unordered_set<uint32_t> m_unsortedTerms; // Terms whose postings are out of page order.
+            std::vector<std::vector<PageToken>> m_pageTokens; // Indexed by page.
+    };
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <memory>
+#include <unordered_map>
+#include "fpdfview.h"
+#include "fpdf_text.h"
+#include "CharGrid.hpp"
+#include "TextSegmentation.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // Text page of a loaded page together with the lookup structures derived from it. The
+    // derived data is built on first use and lives as long as the text page.
+    struct TextPageEntry {
+        FPDF_TEXTPAGE textPage = nullptr;
+        double pageWidth = 0;
+        double pageHeight = 0;
+        PageTransform transform;
+        std::unique_ptr<CharGrid> charGrid;
+        std::unique_ptr<TextSegmentation> segmentation;
+
+        const CharGrid& getCharGrid() {
+            if (!charGrid) {
+                charGrid = std::make_unique<CharGrid>(textPage, transform, pageWidth, pageHeight);
+            }
+            return *charGrid;
+        }
+
+        const TextSegmentation& getSegmentation() {
+            if (!segmentation) {
+                segmentation = std::make_unique<TextSegmentation>(textPage, getCharGrid(), transform);
+            }
+            return *segmentation;
+        }
+    };
+
+    // Caches text pages next to the page cache of HybridPdfiumUtil. Entries must be evicted
+    // before their FPDF_PAGE is closed since a text page refers to its page.
+    class TextPageCache {
+        public:
+            TextPageCache() = default;
+            TextPageCache(const TextPageCache&) = delete;
+            TextPageCache& operator=(const TextPageCache&) = delete;
+            ~TextPageCache() { clear(); }
+
+            // Returns the cached entry for the page, loading the text page if needed. Returns
+            // nullptr if PDFium could not extract the text.
+            TextPageEntry* get(FPDF_PAGE page, int pageIndex) {
+                auto it = m_entries.find(pageIndex);
+                if (it != m_entries.end()) {
+                    return it->second.get();
+                }
+                FPDF_TEXTPAGE textPage = FPDFText_LoadPage(page);
+                if (!textPage) {
+                    return nullptr;
+                }
+                auto entry = std::make_unique<TextPageEntry>();
+                entry->textPage = textPage;
+                entry->pageWidth = FPDF_GetPageWidthF(page);
+                entry->pageHeight = FPDF_GetPageHeightF(page);
+                entry->transform = PageTransform(page);
+                TextPageEntry* result = entry.get();
+                m_entries[pageIndex] = std::move(entry);
+                return result;
+            }
+
+            void evict(int pageIndex) {
+                auto it = m_entries.find(pageIndex);
+                if (it != m_entries.end()) {
+                    FPDFText_ClosePage(it->second->textPage);
+                    m_entries.erase(it);
+                }
+            }
+
+            void clear() {
+                for (auto& entry : m_entries) {
+                    FPDFText_ClosePage(entry.second->textPage);
+                }
+                m_entries.clear();
+            }
+
+        private:
+            std::unordered_map<int, std::unique_ptr<TextPageEntry>> m_entries;
+    };
+}
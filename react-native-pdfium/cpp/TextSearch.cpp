@@ -0,0 +1,111 @@
+#include "TextSearch.hpp"
+#include "fpdf_text.h"
+#include <algorithm>
+#include <iostream>
+
+namespace margelo::nitro::pdfium {
+
+    int TextSearch::start(const std::u16string& query, unsigned long flags, int pageCount, int startPage,
+                          size_t batchSize, ResultsCallback callback) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        int searchId = m_currentId.fetch_add(1) + 1;
+        m_pending = Request{searchId, query, flags, pageCount, startPage, std::max(batchSize, (size_t)1), std::move(callback)};
+
+        if (!m_thread.joinable()) {
+            m_stopRequested = false;
+            m_thread = std::thread(&TextSearch::run, this);
+        }
+        m_condition.notify_one();
+        return searchId;
+    }
+
+    void TextSearch::cancel() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.reset();
+        m_currentId.fetch_add(1);
+    }
+
+    void TextSearch::stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.reset();
+            m_currentId.fetch_add(1);
+            m_stopRequested = true;
+        }
+        m_condition.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void TextSearch::run() {
+        while (true) {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopRequested || m_pending.has_value(); });
+                if (m_stopRequested) {
+                    return;
+                }
+                request = std::move(*m_pending);
+                m_pending.reset();
+            }
+            execute(request);
+        }
+    }
+
+    void TextSearch::execute(const Request& request) {
+        std::vector<TextIndexHit> batch;
+        batch.reserve(request.batchSize);
+        int focus = std::clamp(request.startPage, 0, std::max(request.pageCount - 1, 0));
+
+        for (int distance = 0; distance < request.pageCount; distance++) {
+            // Visit focus, focus + 1, focus - 1, focus + 2, ...
+            for (int side = 0; side < 2; side++) {
+                if (distance == 0 && side == 1) {
+                    continue;
+                }
+                int pageIndex = side == 0 ? focus + distance : focus - distance;
+                if (pageIndex < 0 || pageIndex >= request.pageCount) {
+                    continue;
+                }
+                if (isSuperseded(request.id)) {
+                    return;
+                }
+
+                std::vector<TextIndexHit> pageHits;
+                m_visitor(pageIndex, [&](FPDF_PAGE page) {
+                    FPDF_TEXTPAGE textPage = FPDFText_LoadPage(page);
+                    if (!textPage) {
+                        std::cerr << "Failed to load the text of page " << pageIndex << "." << std::endl;
+                        return;
+                    }
+                    FPDF_SCHHANDLE handle = FPDFText_FindStart(textPage, (FPDF_WIDESTRING)request.query.c_str(), request.flags, 0);
+                    while (handle && !isSuperseded(request.id) && FPDFText_FindNext(handle)) {
+                        pageHits.push_back({pageIndex, FPDFText_GetSchResultIndex(handle), FPDFText_GetSchCount(handle)});
+                    }
+                    if (handle) {
+                        FPDFText_FindClose(handle);
+                    }
+                    FPDFText_ClosePage(textPage);
+                });
+
+                // Deliver outside of the document lock
+                for (const TextIndexHit& hit : pageHits) {
+                    if (isSuperseded(request.id)) {
+                        return;
+                    }
+                    batch.push_back(hit);
+                    if (batch.size() >= request.batchSize) {
+                        request.callback(request.id, batch, false);
+                        batch.clear();
+                    }
+                }
+            }
+        }
+
+        if (!isSuperseded(request.id)) {
+            request.callback(request.id, batch, true);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fpdfview.h"
+#include "TextIndex.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // Runs FPDFText_FindStart / FPDFText_FindNext over the document on a worker thread.
+    // Only the latest search is alive: starting a new one or calling cancel makes the running
+    // one stop at the next match without delivering further results.
+    class TextSearch {
+        public:
+            // Gives the worker access to a page while the document lock is held. Returns false
+            // if the page could not be loaded.
+            using PageVisitor = std::function<bool(int pageIndex, const std::function<void(FPDF_PAGE)>& visit)>;
+            // Receives a batch of hits. `done` is set on the last batch of a search.
+            using ResultsCallback = std::function<void(int searchId, const std::vector<TextIndexHit>& hits, bool done)>;
+
+            explicit TextSearch(PageVisitor visitor) : m_visitor(std::move(visitor)) {}
+            ~TextSearch() { stop(); }
+
+            // Queues a search and returns its id. Pages are searched in order of distance to
+            // `startPage`, so hits near the viewport are delivered first.
+            int start(const std::u16string& query, unsigned long flags, int pageCount, int startPage,
+                      size_t batchSize, ResultsCallback callback);
+            void cancel();
+            void stop();
+
+        private:
+            struct Request {
+                int id;
+                std::u16string query;
+                unsigned long flags;
+                int pageCount;
+                int startPage;
+                size_t batchSize;
+                ResultsCallback callback;
+            };
+
+            void run();
+            void execute(const Request& request);
+            bool isSuperseded(int searchId) const { return m_currentId.load() != searchId; }
+
+            PageVisitor m_visitor;
+            std::thread m_thread;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::optional<Request> m_pending;
+            bool m_stopRequested = false;
+            std::atomic<int> m_currentId{0};
+    };
+}
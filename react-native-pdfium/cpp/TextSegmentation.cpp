@@ -0,0 +1,160 @@
+#include "TextSegmentation.hpp"
+#include "TextUtils.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace margelo::nitro::pdfium {
+
+    // Thresholds relative to the font size of the current word or line
+    static constexpr double kFontSizeChangeRatio = 0.2;
+    static constexpr double kBaselineTolerance = 0.5;
+    static constexpr double kWordGap = 0.3;
+    static constexpr double kLineGap = 2.5;
+    // Distance in points a tap may miss a word by
+    static constexpr double kWordHitTolerance = 3.0;
+
+    namespace {
+        struct CharInfo {
+            char32_t unicode;
+            double fontSize;
+            double baseline;
+            bool hasBox;
+        };
+
+        void extend(TextSegmentBox& segment, const CharGrid::Box& box) {
+            segment.left = std::min(segment.left, box.left);
+            segment.top = std::min(segment.top, box.top);
+            segment.right = std::max(segment.right, box.right);
+            segment.bottom = std::max(segment.bottom, box.bottom);
+        }
+
+        TextSegmentBox startSegment(uint32_t charIndex, const CharGrid::Box& box) {
+            return TextSegmentBox{charIndex, 1, box.left, box.top, box.right, box.bottom};
+        }
+    }
+
+    TextSegmentation::TextSegmentation(FPDF_TEXTPAGE textPage, const CharGrid& charGrid, const PageTransform& transform) {
+        int count = charGrid.charCount();
+
+        std::vector<CharInfo> chars(count);
+        for (int i = 0; i < count; i++) {
+            const CharGrid::Box& box = charGrid.boxOf(i);
+            double originX = 0, originY = 0, displayX = 0, displayY = 0;
+            FPDFText_GetCharOrigin(textPage, i, &originX, &originY);
+            transform.toDisplay(originX, originY, displayX, displayY);
+            chars[i] = CharInfo{
+                (char32_t)FPDFText_GetUnicode(textPage, i),
+                FPDFText_GetFontSize(textPage, i),
+                displayY,
+                box.right > box.left && FPDFText_IsGenerated(textPage, i) != 1
+            };
+        }
+
+        // Words
+        std::optional<TextSegmentBox> word;
+        double wordFontSize = 0, wordBaseline = 0;
+        auto flushWord = [&]() {
+            if (word) {
+                m_words.push_back(*word);
+                word.reset();
+            }
+        };
+
+        for (int i = 0; i < count; i++) {
+            const CharInfo& info = chars[i];
+            if (!info.hasBox || info.unicode <= ' ' || info.unicode == 0xA0 || info.unicode == 0x3000) {
+                flushWord();
+                continue;
+            }
+            const CharGrid::Box& box = charGrid.boxOf(i);
+            bool wordChar = isWordChar(info.unicode) && !isIdeographic(info.unicode);
+
+            if (word) {
+                double size = std::max(wordFontSize, 1.0);
+                bool sizeChanged = std::abs(info.fontSize - wordFontSize) > size * kFontSizeChangeRatio;
+                bool baselineChanged = std::abs(info.baseline - wordBaseline) > size * kBaselineTolerance;
+                bool gap = box.left - word->right > size * kWordGap || box.right < word->left;
+                bool contiguous = word->firstChar + word->charCount == (uint32_t)i;
+                if (!wordChar || sizeChanged || baselineChanged || gap || !contiguous) {
+                    flushWord();
+                }
+            }
+
+            if (!wordChar) {
+                // Punctuation and ideographs are words of their own
+                m_words.push_back(startSegment(i, box));
+                continue;
+            }
+            if (!word) {
+                word = startSegment(i, box);
+                wordFontSize = info.fontSize;
+                wordBaseline = info.baseline;
+            } else {
+                word->charCount = i - word->firstChar + 1;
+                extend(*word, box);
+            }
+        }
+        flushWord();
+
+        // Lines
+        std::optional<TextSegmentBox> line;
+        double lineFontSize = 0, lineBaseline = 0;
+        for (const TextSegmentBox& w : m_words) {
+            const CharInfo& info = chars[w.firstChar];
+            if (line) {
+                double size = std::max(lineFontSize, 1.0);
+                bool baselineChanged = std::abs(info.baseline - lineBaseline) > size * kBaselineTolerance;
+                bool movedLeft = w.left < line->right - size;
+                bool farAway = w.left - line->right > size * kLineGap;
+                if (baselineChanged || movedLeft || farAway) {
+                    m_lines.push_back(*line);
+                    line.reset();
+                }
+            }
+            if (!line) {
+                line = w;
+                lineFontSize = info.fontSize;
+                lineBaseline = info.baseline;
+            } else {
+                line->charCount = w.firstChar + w.charCount - line->firstChar;
+                line->left = std::min(line->left, w.left);
+                line->top = std::min(line->top, w.top);
+                line->right = std::max(line->right, w.right);
+                line->bottom = std::max(line->bottom, w.bottom);
+            }
+        }
+        if (line) {
+            m_lines.push_back(*line);
+        }
+    }
+
+    std::optional<TextSegmentBox> TextSegmentation::wordAt(const CharGrid& charGrid, double x, double y) const {
+        int charIndex = charGrid.charIndexAt(x, y, kWordHitTolerance);
+        if (charIndex < 0) {
+            return std::nullopt;
+        }
+        // Last word starting at or before the character
+        auto it = std::upper_bound(m_words.begin(), m_words.end(), (uint32_t)charIndex,
+                                   [](uint32_t index, const TextSegmentBox& w) { return index < w.firstChar; });
+        if (it == m_words.begin()) {
+            return std::nullopt;
+        }
+        --it;
+        if ((uint32_t)charIndex >= it->firstChar + it->charCount) {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    std::vector<TextSegmentBox> TextSegmentation::linesInRect(double left, double top, double right, double bottom) const {
+        if (right < left) std::swap(left, right);
+        if (bottom < top) std::swap(top, bottom);
+        std::vector<TextSegmentBox> result;
+        for (const TextSegmentBox& line : m_lines) {
+            if (line.left <= right && line.right >= left && line.top <= bottom && line.bottom >= top) {
+                result.push_back(line);
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "fpdf_text.h"
+#include "CharGrid.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // A run of characters with its bounding box in page points (top-left origin)
+    struct TextSegmentBox {
+        uint32_t firstChar;
+        uint32_t charCount;
+        float left;
+        float top;
+        float right;
+        float bottom;
+    };
+
+    // Splits the characters of a text page into words and lines. Words break on whitespace,
+    // generated characters, punctuation, font size changes and large horizontal gaps. Words
+    // are joined into lines while their baselines agree and they continue to the right.
+    // Computed once per text page so selection gestures never have to go back to PDFium.
+    class TextSegmentation {
+        public:
+            TextSegmentation(FPDF_TEXTPAGE textPage, const CharGrid& charGrid, const PageTransform& transform);
+
+            // Word under the point, or the closest word within a few points of it
+            std::optional<TextSegmentBox> wordAt(const CharGrid& charGrid, double x, double y) const;
+            std::vector<TextSegmentBox> linesInRect(double left, double top, double right, double bottom) const;
+
+            const std::vector<TextSegmentBox>& words() const { return m_words; }
+            const std::vector<TextSegmentBox>& lines() const { return m_lines; }
+
+        private:
+            std::vector<TextSegmentBox> m_words; // Ordered by first character
+            std::vector<TextSegmentBox> m_lines; // Ordered by first character
+    };
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "fpdf_text.h"
+
+namespace margelo::nitro::pdfium {
+
+    // Reads `count` characters of a text page as UTF-16 code units. PDFium writes a trailing
+    // terminator, so the buffer is allocated one unit larger and trimmed afterwards.
+    inline std::u16string getPageText(FPDF_TEXTPAGE textPage, int startIndex, int count) {
+        std::u16string text;
+        if (!textPage || count <= 0) {
+            return text;
+        }
+        std::vector<unsigned short> buffer(count + 1, 0);
+        int written = FPDFText_GetText(textPage, startIndex, count, buffer.data());
+        if (written <= 1) {
+            return text;
+        }
+        text.assign(buffer.begin(), buffer.begin() + (written - 1));
+        return text;
+    }
+
+    inline void appendUtf8(std::string& out, char32_t codePoint) {
+        if (codePoint < 0x80) {
+            out.push_back((char)codePoint);
+        } else if (codePoint < 0x800) {
+            out.push_back((char)(0xC0 | (codePoint >> 6)));
+            out.push_back((char)(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            out.push_back((char)(0xE0 | (codePoint >> 12)));
+            out.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (codePoint & 0x3F)));
+        } else {
+            out.push_back((char)(0xF0 | (codePoint >> 18)));
+            out.push_back((char)(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back((char)(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    // Encodes UTF-16 coming from PDFium as UTF-8 for JS. Unpaired surrogates are dropped.
+    inline std::string utf16ToUtf8(const char16_t* text, size_t length) {
+        std::string out;
+        out.reserve(length);
+        for (size_t i = 0; i < length; i++) {
+            char32_t c = text[i];
+            if (c >= 0xD800 && c <= 0xDBFF) {
+                if (i + 1 >= length || text[i + 1] < 0xDC00 || text[i + 1] > 0xDFFF) {
+                    continue;
+                }
+                c = 0x10000 + ((c - 0xD800) << 10) + (text[++i] - 0xDC00);
+            } else if (c >= 0xDC00 && c <= 0xDFFF) {
+                continue;
+            }
+            appendUtf8(out, c);
+        }
+        return out;
+    }
+
+    // Decodes UTF-8 coming from JS into UTF-16 as expected by FPDF_WIDESTRING APIs.
+    // Invalid sequences are skipped rather than rejected.
+    inline std::u16string utf8ToUtf16(const std::string& in) {
+        std::u16string out;
+        out.reserve(in.size());
+        size_t i = 0;
+        while (i < in.size()) {
+            unsigned char c = (unsigned char)in[i];
+            char32_t codePoint = 0;
+            int extra = 0;
+            if (c < 0x80) { codePoint = c; extra = 0; }
+            else if ((c & 0xE0) == 0xC0) { codePoint = c & 0x1F; extra = 1; }
+            else if ((c & 0xF0) == 0xE0) { codePoint = c & 0x0F; extra = 2; }
+            else if ((c & 0xF8) == 0xF0) { codePoint = c & 0x07; extra = 3; }
+            else { i++; continue; }
+
+            if (i + extra >= in.size() && extra > 0) {
+                break;
+            }
+            for (int k = 1; k <= extra; k++) {
+                codePoint = (codePoint << 6) | ((unsigned char)in[i + k] & 0x3F);
+            }
+            i += extra + 1;
+
+            if (codePoint >= 0x10000) {
+                codePoint -= 0x10000;
+                out.push_back((char16_t)(0xD800 + (codePoint >> 10)));
+                out.push_back((char16_t)(0xDC00 + (codePoint & 0x3FF)));
+            } else {
+                out.push_back((char16_t)codePoint);
+            }
+        }
+        return out;
+    }
+
+    // Simple case folding that covers Latin, Greek and Cyrillic. Good enough for search
+    // normalization without pulling ICU into the module.
+    inline char32_t foldCase(char32_t c) {
+        if (c >= 'A' && c <= 'Z') return c + 32;
+        if (c < 0x80) return c;
+        if ((c >= 0xC0 && c <= 0xDE) && c != 0xD7) return c + 32;
+        if (((c >= 0x100 && c <= 0x137) || (c >= 0x14A && c <= 0x177)) && (c % 2) == 0) return c + 1;
+        if (c >= 0x391 && c <= 0x3AB && c != 0x3A2) return c + 32;
+        if (c >= 0x410 && c <= 0x42F) return c + 32;
+        if (c >= 0x400 && c <= 0x40F) return c + 80;
+        return c;
+    }
+
+    // Ideographic and kana characters are indexed one character per term since these
+    // scripts do not separate words with spaces.
+    inline bool isIdeographic(char32_t c) {
+        return (c >= 0x3040 && c <= 0x30FF) || (c >= 0x3400 && c <= 0x4DBF) ||
+               (c >= 0x4E00 && c <= 0x9FFF) || (c >= 0xAC00 && c <= 0xD7AF) ||
+               (c >= 0xF900 && c <= 0xFAFF);
+    }
+
+    inline bool isWordChar(char32_t c) {
+        if (c < 0x80) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+        // Latin-1 punctuation, general punctuation and spaces are separators. Everything
+        // else above ASCII is treated as a letter.
+        if (c <= 0xBF || c == 0xD7 || c == 0xF7) return false;
+        if (c >= 0x2000 && c <= 0x206F) return false;
+        if (c >= 0x3000 && c <= 0x303F) return false;
+        if (c == 0xFEFF || c == 0xFFFE || c == 0xFFFF) return false;
+        return true;
+    }
+
+    // A token of normalized text together with the character range it was read from.
+    struct TextToken {
+        std::string term;
+        int charStart;
+        int charCount;
+    };
+
+    // Splits UTF-16 text into normalized terms. Character offsets are reported in UTF-16
+    // units, which matches PDFium character indices for BMP text.
+    inline std::vector<TextToken> tokenizeText(const std::u16string& text) {
+        std::vector<TextToken> tokens;
+        TextToken current{"", -1, 0};
+
+        auto flush = [&](int end) {
+            if (current.charStart >= 0) {
+                current.charCount = end - current.charStart;
+                tokens.push_back(std::move(current));
+            }
+            current = TextToken{"", -1, 0};
+        };
+
+        for (size_t i = 0; i < text.size(); i++) {
+            char32_t c = text[i];
+            size_t width = 1;
+            if (c >= 0xD800 && c <= 0xDBFF && i + 1 < text.size()) {
+                char32_t low = text[i + 1];
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                    c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                    width = 2;
+                }
+            }
+
+            if (!isWordChar(c)) {
+                flush((int)i);
+            } else if (isIdeographic(c)) {
+                flush((int)i);
+                current.charStart = (int)i;
+                appendUtf8(current.term, c);
+                flush((int)(i + width));
+            } else {
+                if (current.charStart < 0) {
+                    current.charStart = (int)i;
+                }
+                appendUtf8(current.term, foldCase(c));
+            }
+            i += width - 1;
+        }
+        flush((int)text.size());
+        return tokens;
+    }
+}
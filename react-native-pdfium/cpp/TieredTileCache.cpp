@@ -0,0 +1,128 @@
+#include "TieredTileCache.hpp"
+#include "BufferUtils.hpp"
+#include "TileCompression.hpp"
+#include <chrono>
+
+namespace margelo::nitro::pdfium {
+
+    static size_t tileBytes(const RenderedTile& tile) {
+        return tile.buffer->size() + (tile.palette ? (*tile.palette)->size() : 0);
+    }
+
+    TieredTileCache::TieredTileCache(size_t hotEntries, size_t hotBytes, size_t compressedEntries, size_t compressedBytes)
+        : m_hot(hotEntries, hotBytes, tileBytes),
+          m_compressed(compressedEntries, compressedBytes, [](const CompressedTile& tile) {
+              return tile.data->size() + (tile.tile.palette ? (*tile.tile.palette)->size() : 0);
+          }) {
+        m_compressed.setEvictionListener([this](const TileKey&, const CompressedTile& tile, EvictionReason) {
+            m_uncompressedBytes -= tile.size;
+        });
+        // Runs with the hot tier locked, so tiles are only queued here and compressed after.
+        // Replaced, erased and cleared tiles are not worth keeping, only those pushed out are.
+        m_hot.setEvictionListener([this](const TileKey& key, const RenderedTile& tile, EvictionReason reason) {
+            if (reason == EvictionReason::CAPACITY) {
+                demote(key, tile);
+            }
+        });
+    }
+
+    void TieredTileCache::demote(const TileKey& key, const RenderedTile& tile) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_demoted.emplace_back(key, tile);
+    }
+
+    void TieredTileCache::compressDemoted() {
+        std::vector<std::pair<TileKey, RenderedTile>> demoted;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            demoted.swap(m_demoted);
+        }
+        for (auto& [key, tile] : demoted) {
+            size_t size = tile.buffer->size();
+            int unitSize = getRleUnitSize(tile.colorType);
+            auto data = std::make_shared<std::vector<uint8_t>>(compressRle(tile.buffer->data(), size, unitSize));
+            if (data->size() >= size) {
+                // Photos and noise do not compress, keep them as they are
+                data = std::make_shared<std::vector<uint8_t>>(tile.buffer->data(), tile.buffer->data() + size);
+                unitSize = 0;
+            }
+            RenderedTile stripped = tile;
+            stripped.buffer = allocateBuffer(0);
+            m_uncompressedBytes += size;
+            m_compressed.put(key, CompressedTile{stripped, data, size, unitSize});
+        }
+    }
+
+    std::optional<RenderedTile> TieredTileCache::get(const TileKey& key) {
+        std::optional<RenderedTile> hot = m_hot.get(key);
+        if (hot) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.hotHits++;
+            return hot;
+        }
+
+        std::optional<CompressedTile> compressed = m_compressed.get(key);
+        if (!compressed) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.misses++;
+            return std::nullopt;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<ArrayBuffer> buffer = allocateBuffer(compressed->size);
+        uint8_t* stream = buffer->data();
+        const std::vector<uint8_t>& data = *compressed->data;
+        if (compressed->unitSize == 0) {
+            std::copy(data.begin(), data.end(), stream);
+        } else if (!decompressRle(data.data(), data.size(), compressed->unitSize, stream, compressed->size)) {
+            m_compressed.erase(key);
+            return std::nullopt;
+        }
+        double decompressMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        RenderedTile tile = compressed->tile;
+        tile.buffer = buffer;
+        m_compressed.erase(key);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.compressedHits++;
+            m_decompressMs += decompressMs;
+        }
+        m_hot.put(key, tile);
+        compressDemoted();
+        return tile;
+    }
+
+    void TieredTileCache::put(const TileKey& key, const RenderedTile& tile, double renderMs) {
+        if (renderMs >= 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_renders++;
+            m_renderMs += renderMs;
+        }
+        m_hot.put(key, tile);
+        compressDemoted();
+    }
+
+    void TieredTileCache::clear() {
+        m_hot.clear();
+        m_compressed.clear();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_demoted.clear();
+    }
+
+    TieredTileCacheStats TieredTileCache::getStats() {
+        // The tiers call into m_mutex while locked themselves, so read them before taking it
+        size_t hotTiles = m_hot.size(), hotBytes = m_hot.weight();
+        size_t compressedTiles = m_compressed.size(), compressedBytes = m_compressed.weight();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TieredTileCacheStats stats = m_stats;
+        stats.hotTiles = hotTiles;
+        stats.hotBytes = hotBytes;
+        stats.compressedTiles = compressedTiles;
+        stats.compressedBytes = compressedBytes;
+        stats.uncompressedBytes = m_uncompressedBytes;
+        stats.averageDecompressMs = stats.compressedHits > 0 ? m_decompressMs / stats.compressedHits : 0;
+        stats.averageRenderMs = m_renders > 0 ? m_renderMs / m_renders : 0;
+        return stats;
+    }
+}
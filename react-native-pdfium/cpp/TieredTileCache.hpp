@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "RenderedTile.hpp"
+#include "TileCache.hpp"
+#include "TileKey.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    struct TieredTileCacheStats {
+        size_t hotTiles = 0;
+        size_t hotBytes = 0;
+        size_t compressedTiles = 0;
+        size_t compressedBytes = 0;   // Memory used by the compressed tier
+        size_t uncompressedBytes = 0; // What the compressed tier would take uncompressed
+        size_t hotHits = 0;
+        size_t compressedHits = 0;
+        size_t misses = 0;
+        double averageDecompressMs = 0;
+        double averageRenderMs = 0;
+    };
+
+    // Rendered tiles in two tiers: a hot LRU of ready to use buffers and, behind it, an LRU of
+    // tiles the hot tier evicted, kept run-length compressed. A compressed hit is decoded and
+    // promoted back to the hot tier, which is far cheaper than rendering it again.
+    class TieredTileCache {
+        public:
+            TieredTileCache(size_t hotEntries, size_t hotBytes, size_t compressedEntries, size_t compressedBytes);
+
+            std::optional<RenderedTile> get(const TileKey& key);
+            // renderMs is the time it took to render the tile, for the stats. Negative for tiles
+            // that were not rendered, such as ones loaded from disk.
+            void put(const TileKey& key, const RenderedTile& tile, double renderMs);
+            void clear();
+            TieredTileCacheStats getStats();
+
+        private:
+            struct CompressedTile {
+                RenderedTile tile;  // Everything but the pixels
+                std::shared_ptr<const std::vector<uint8_t>> data;
+                size_t size;        // Size of the decoded pixels
+                int unitSize;       // 0 if data holds the pixels as is
+            };
+
+            void demote(const TileKey& key, const RenderedTile& tile);
+            void compressDemoted();
+
+            LRUCache<TileKey, RenderedTile> m_hot;
+            LRUCache<TileKey, CompressedTile> m_compressed;
+            std::mutex m_mutex; // Guards the demoted list and the stats
+            std::vector<std::pair<TileKey, RenderedTile>> m_demoted;
+            std::atomic<size_t> m_uncompressedBytes{0};
+            TieredTileCacheStats m_stats;
+            double m_decompressMs = 0;
+            double m_renderMs = 0;
+            size_t m_renders = 0;
+    };
+}
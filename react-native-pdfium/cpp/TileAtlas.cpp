@@ -0,0 +1,52 @@
+#include "TileAtlas.hpp"
+#include <algorithm>
+
+namespace margelo::nitro::pdfium {
+
+    TileAtlas::TileAtlas(int slotSize, int columns, int rows)
+        : m_slotSize(std::max(slotSize, 1)), m_columns(std::max(columns, 1)), m_rows(std::max(rows, 1)) {
+        int slotCount = getSlotCount();
+        m_positions.reserve(slotCount);
+        m_keys.resize(slotCount);
+        for (int slot = 0; slot < slotCount; slot++) {
+            m_positions.push_back(m_order.insert(m_order.end(), slot));
+        }
+    }
+
+    void TileAtlas::touch(int slot) {
+        m_order.splice(m_order.begin(), m_order, m_positions[slot]);
+    }
+
+    int TileAtlas::find(const TileKey& key) {
+        auto it = m_slots.find(key);
+        if (it == m_slots.end()) {
+            return -1;
+        }
+        touch(it->second);
+        return it->second;
+    }
+
+    int TileAtlas::assign(const TileKey& key) {
+        int slot = m_order.back();
+        if (m_keys[slot]) {
+            m_slots.erase(*m_keys[slot]);
+        }
+        m_keys[slot] = key;
+        m_slots[key] = slot;
+        touch(slot);
+        return slot;
+    }
+
+    void TileAtlas::release(int slot) {
+        if (m_keys[slot]) {
+            m_slots.erase(*m_keys[slot]);
+            m_keys[slot] = std::nullopt;
+        }
+        m_order.splice(m_order.end(), m_order, m_positions[slot]);
+    }
+
+    void TileAtlas::clear() {
+        m_slots.clear();
+        std::fill(m_keys.begin(), m_keys.end(), std::nullopt);
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "TileKey.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // Slot bookkeeping of a tile atlas: a grid of equally sized slots in one large image. Tiles
+    // keep their slot while they are used, the least recently used slot is recycled for new
+    // ones. Holds no pixels.
+    class TileAtlas {
+        public:
+            TileAtlas(int slotSize, int columns, int rows);
+
+            int getSlotSize() const { return m_slotSize; }
+            int getSlotCount() const { return m_columns * m_rows; }
+            int getSlotX(int slot) const { return (slot % m_columns) * m_slotSize; }
+            int getSlotY(int slot) const { return (slot / m_columns) * m_slotSize; }
+
+            // Slot holding the tile, marked as most recently used. -1 if the tile is not resident.
+            int find(const TileKey& key);
+            // Gives the least recently used slot to the tile and marks it as most recently used
+            int assign(const TileKey& key);
+            // Empties the slot, e.g. when drawing its tile failed, and makes it the next to recycle
+            void release(int slot);
+            void clear();
+
+        private:
+            void touch(int slot);
+
+            int m_slotSize;
+            int m_columns;
+            int m_rows;
+            std::list<int> m_order; // Slots, most recently used first
+            std::vector<std::list<int>::iterator> m_positions;
+            std::vector<std::optional<TileKey>> m_keys;
+            std::unordered_map<TileKey, int> m_slots;
+    };
+}
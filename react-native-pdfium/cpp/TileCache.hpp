@@ -5,7 +5,10 @@
 //  Created by Dimuthu Wannipurage on 3/3/25.
 //
 
+#pragma once
 #include <iostream>
+#include <functional>
+#include <optional>
 #include <unordered_map>
 #include <list>
 #include <stdexcept>
@@ -13,10 +16,30 @@
 
 namespace margelo::nitro::pdfium {
 
+// Why an entry left the cache
+enum class EvictionReason {
+    CAPACITY, // Least recently used beyond the capacity or weight bound
+    REPLACED, // Overwritten by a put with the same key, which stays cached
+    ERASED,
+    CLEARED
+};
+
 template<typename Key, typename Value>
 class LRUCache {
     public:
+        // Returns the weight of an entry, e.g. its size in bytes
+        using Weigher = std::function<size_t(const Value&)>;
+        // Called with the entries that leave the cache, whether evicted, replaced, erased or cleared
+        using EvictionListener = std::function<void(const Key&, const Value&, EvictionReason)>;
+
+        LRUCache() = default;
+        explicit LRUCache(size_t capacity) : capacity_(capacity) {}
+        // Bounds the cache by the total weight of its entries as well as their count. Entries
+        // weighing 0 only count against the capacity.
+        LRUCache(size_t capacity, size_t maxWeight, Weigher weigher)
+            : capacity_(capacity), maxWeight_(maxWeight), weigher_(std::move(weigher)) {}
         
+
         std::optional<Value> get(const Key &key) {
             std::lock_guard<std::mutex> lock(mutex_);
             auto it = cacheItemsMap.find(key);
@@ -33,24 +56,81 @@ class LRUCache {
             auto it = cacheItemsMap.find(key);
             if (it != cacheItemsMap.end()) {
                 // Update existing item and move it to the front.
+                weight_ -= weigh(it->second->second);
+                notifyEvicted(*it->second, EvictionReason::REPLACED);
                 it->second->second = value;
+                weight_ += weigh(value);
                 cacheItemsList.splice(cacheItemsList.begin(), cacheItemsList, it->second);
             } else {
-                if (cacheItemsMap.size() == capacity_) {
-                    // Remove the least recently used item (back of the list).
-                    auto last = cacheItemsList.end();
-                    --last;
-                    cacheItemsMap.erase(last->first);
-                    cacheItemsList.pop_back();
-                }
                 // Insert the new key-value pair at the front of the list.
                 cacheItemsList.push_front(std::make_pair(key, value));
                 cacheItemsMap[key] = cacheItemsList.begin();
+                weight_ += weigh(value);
+            }
+            // Remove the least recently used items (back of the list), never the one just put.
+            while (cacheItemsMap.size() > 1 &&
+                   (cacheItemsMap.size() > capacity_ || (maxWeight_ > 0 && weight_ > maxWeight_))) {
+                auto last = cacheItemsList.end();
+                --last;
+                weight_ -= weigh(last->second);
+                notifyEvicted(*last, EvictionReason::CAPACITY);
+                cacheItemsMap.erase(last->first);
+                cacheItemsList.pop_back();
+            }
+        }
+
+        void erase(const Key &key) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = cacheItemsMap.find(key);
+            if (it != cacheItemsMap.end()) {
+                weight_ -= weigh(it->second->second);
+                notifyEvicted(*it->second, EvictionReason::ERASED);
+                cacheItemsList.erase(it->second);
+                cacheItemsMap.erase(it);
+            }
+        }
+
+        void setEvictionListener(EvictionListener listener) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            listener_ = std::move(listener);
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& item : cacheItemsList) {
+                notifyEvicted(item, EvictionReason::CLEARED);
             }
+            cacheItemsMap.clear();
+            cacheItemsList.clear();
+            weight_ = 0;
+        }
+
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return cacheItemsMap.size();
+        }
+
+        size_t weight() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return weight_;
         }
         
     private:
+        size_t weigh(const Value& value) const {
+            return weigher_ ? weigher_(value) : 0;
+        }
+
+        void notifyEvicted(const std::pair<Key, Value>& item, EvictionReason reason) {
+            if (listener_) {
+                listener_(item.first, item.second, reason);
+            }
+        }
+
         size_t capacity_ = 10;
+        size_t maxWeight_ = 0; // 0 means unbounded
+        size_t weight_ = 0;
+        Weigher weigher_;
+        EvictionListener listener_;
         std::list<std::pair<Key, Value>> cacheItemsList;
         std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> cacheItemsMap;
         mutable std::mutex mutex_; // Protects the internal data structures.
@@ -0,0 +1,73 @@
+#include "TileCompression.hpp"
+#include <cstring>
+
+namespace margelo::nitro::pdfium {
+
+    static constexpr size_t kMaxLiteral = 128;
+    static constexpr size_t kMaxRun = 129;
+
+    std::vector<uint8_t> compressRle(const uint8_t* data, size_t size, int unitSize) {
+        std::vector<uint8_t> out;
+        out.reserve(size / 16);
+        size_t units = size / unitSize;
+        auto same = [&](size_t a, size_t b) {
+            return std::memcmp(data + a * unitSize, data + b * unitSize, unitSize) == 0;
+        };
+
+        size_t i = 0;
+        while (i < units) {
+            size_t run = 1;
+            while (i + run < units && run < kMaxRun && same(i, i + run)) {
+                run++;
+            }
+            if (run >= 2) {
+                out.push_back((uint8_t)(run + 126));
+                out.insert(out.end(), data + i * unitSize, data + (i + 1) * unitSize);
+                i += run;
+                continue;
+            }
+
+            // Literals extend up to the next pair of equal units
+            size_t literal = 1;
+            while (i + literal < units && literal < kMaxLiteral &&
+                   !(i + literal + 1 < units && same(i + literal, i + literal + 1))) {
+                literal++;
+            }
+            out.push_back((uint8_t)(literal - 1));
+            out.insert(out.end(), data + i * unitSize, data + (i + literal) * unitSize);
+            i += literal;
+        }
+        return out;
+    }
+
+    bool decompressRle(const uint8_t* data, size_t dataSize, int unitSize, uint8_t* out, size_t size) {
+        size_t in = 0, written = 0;
+        while (in < dataSize) {
+            uint8_t control = data[in++];
+            if (control < 128) {
+                size_t bytes = (size_t)(control + 1) * unitSize;
+                if (in + bytes > dataSize || written + bytes > size) {
+                    return false;
+                }
+                std::memcpy(out + written, data + in, bytes);
+                in += bytes;
+                written += bytes;
+            } else {
+                size_t count = control - 126;
+                if (in + unitSize > dataSize || written + count * unitSize > size) {
+                    return false;
+                }
+                if (unitSize == 1) {
+                    std::memset(out + written, data[in], count);
+                } else {
+                    for (size_t i = 0; i < count; i++) {
+                        std::memcpy(out + written + i * unitSize, data + in, unitSize);
+                    }
+                }
+                in += unitSize;
+                written += count * unitSize;
+            }
+        }
+        return written == size;
+    }
+}
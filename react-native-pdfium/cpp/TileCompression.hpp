@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "TileColorType.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // PackBits style run-length coding over units of 1 or 4 bytes, so that a run is a run of
+    // whole pixels. Rendered pages are mostly long runs of background, which this shrinks
+    // many times over while decoding at memcpy speed. A control byte n < 128 is followed by
+    // n + 1 literal units, n >= 128 by one unit repeated n - 126 times.
+    std::vector<uint8_t> compressRle(const uint8_t* data, size_t size, int unitSize);
+
+    // Runs are counted in whole pixels for the 4 byte formats
+    inline int getRleUnitSize(TileColorType colorType) {
+        switch (colorType) {
+            case TileColorType::GRAY8:
+            case TileColorType::PALETTE4:
+                return 1;
+            default:
+                return 4;
+        }
+    }
+
+    // Returns false if the input is malformed or does not decode to exactly `size` bytes
+    bool decompressRle(const uint8_t* data, size_t dataSize, int unitSize, uint8_t* out, size_t size);
+}
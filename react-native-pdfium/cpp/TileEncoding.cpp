@@ -0,0 +1,156 @@
+#include "TileEncoding.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace margelo::nitro::pdfium {
+
+    // Thumbnail used to classify a page
+    static constexpr int kProbeWidth = 96;
+    // Channel difference above which a pixel counts as colored
+    static constexpr int kColorThreshold = 24;
+    // Fraction of colored probe pixels tolerated on a gray page (stray antialiasing)
+    static constexpr double kColorPixelRatio = 0.001;
+
+    bool findUniformPixel(const uint8_t* pixels, int width, int height, int stride, int bytesPerPixel, bool opaque, uint32_t& pixel) {
+        if (width <= 0 || height <= 0) {
+            return false;
+        }
+        uint64_t pattern, mask;
+        if (bytesPerPixel == 1) {
+            pattern = pixels[0] * 0x0101010101010101ULL;
+            mask = ~0ULL;
+        } else {
+            uint32_t first, firstMask = opaque ? 0x00ffffff : 0xffffffff;
+            std::memcpy(&first, pixels, 4);
+            pattern = ((uint64_t)first << 32 | first);
+            mask = ((uint64_t)firstMask << 32 | firstMask);
+            pattern &= mask;
+        }
+
+        // Rows are compared 8 bytes at a time, accumulating differences without branching so the
+        // compiler can vectorize the inner loop. Words never straddle a pixel since 8 is a
+        // multiple of the pixel size.
+        size_t rowBytes = (size_t)width * bytesPerPixel;
+        size_t words = rowBytes / 8;
+        for (int y = 0; y < height; y++) {
+            const uint8_t* row = pixels + (size_t)y * stride;
+            uint64_t diff = 0;
+            for (size_t i = 0; i < words; i++) {
+                uint64_t word;
+                std::memcpy(&word, row + i * 8, 8);
+                diff |= (word & mask) ^ pattern;
+            }
+            for (size_t i = words * 8; i < rowBytes; i++) {
+                size_t shift = (i % 8) * 8;
+                diff |= ((row[i] ^ (pattern >> shift)) & (mask >> shift)) & 0xff;
+            }
+            if (diff != 0) {
+                return false;
+            }
+        }
+        pixel = (uint32_t)pattern;
+        return true;
+    }
+
+    bool isGrayscalePage(FPDF_PAGE page) {
+        double pageWidth = FPDF_GetPageWidthF(page);
+        double pageHeight = FPDF_GetPageHeightF(page);
+        if (pageWidth <= 0 || pageHeight <= 0) {
+            return false;
+        }
+
+        int width = kProbeWidth;
+        int height = std::max(1, (int)(kProbeWidth * pageHeight / pageWidth));
+        std::vector<uint8_t> pixels(width * height * 4);
+        FPDF_BITMAP bitmap = FPDFBitmap_CreateEx(width, height, FPDFBitmap_BGRx, pixels.data(), width * 4);
+        if (!bitmap) {
+            return false;
+        }
+        FPDFBitmap_FillRect(bitmap, 0, 0, width, height, 0xffffffff);
+        FPDF_RenderPageBitmap(bitmap, page, 0, 0, width, height, 0, 0);
+        FPDFBitmap_Destroy(bitmap);
+
+        int colored = 0;
+        for (int i = 0; i < width * height; i++) {
+            int b = pixels[i * 4], g = pixels[i * 4 + 1], r = pixels[i * 4 + 2];
+            if (std::abs(r - g) > kColorThreshold || std::abs(g - b) > kColorThreshold || std::abs(r - b) > kColorThreshold) {
+                colored++;
+            }
+        }
+        return colored <= width * height * kColorPixelRatio;
+    }
+
+    Palette4Tile packGrayToPalette4(const uint8_t* gray, int width, int height, int stride) {
+        Palette4Tile out;
+        out.rowBytes = (width + 1) / 2;
+        out.pixels.assign((size_t)out.rowBytes * height, 0);
+        for (int i = 0; i < kPaletteSize; i++) {
+            uint32_t level = i * 255 / (kPaletteSize - 1);
+            out.palette[i] = 0xff000000 | (level << 16) | (level << 8) | level;
+        }
+
+        for (int y = 0; y < height; y++) {
+            const uint8_t* src = gray + (size_t)y * stride;
+            uint8_t* dst = out.pixels.data() + (size_t)y * out.rowBytes;
+            for (int x = 0; x < width; x++) {
+                uint8_t index = (uint8_t)((src[x] * (kPaletteSize - 1) + 127) / 255);
+                dst[x >> 1] |= (x & 1) ? index : (uint8_t)(index << 4);
+            }
+        }
+        return out;
+    }
+
+    bool tryPackColorToPalette4(const uint8_t* pixels, int width, int height, int stride, bool opaque, Palette4Tile& out) {
+        std::array<uint32_t, kPaletteSize> palette{};
+        int paletteCount = 0;
+        // Padding bytes of opaque formats are not guaranteed to be consistent
+        uint32_t mask = opaque ? 0x00ffffff : 0xffffffff;
+
+        std::vector<uint8_t> packed((size_t)((width + 1) / 2) * height, 0);
+        int rowBytes = (width + 1) / 2;
+        uint32_t lastColor = 0;
+        int lastIndex = -1;
+
+        for (int y = 0; y < height; y++) {
+            const uint8_t* src = pixels + (size_t)y * stride;
+            uint8_t* dst = packed.data() + (size_t)y * rowBytes;
+            for (int x = 0; x < width; x++) {
+                uint32_t color;
+                std::memcpy(&color, src + x * 4, 4);
+                color &= mask;
+
+                int index = lastIndex;
+                if (index < 0 || color != lastColor) {
+                    index = -1;
+                    for (int i = 0; i < paletteCount; i++) {
+                        if (palette[i] == color) {
+                            index = i;
+                            break;
+                        }
+                    }
+                    if (index < 0) {
+                        if (paletteCount == kPaletteSize) {
+                            return false;
+                        }
+                        palette[paletteCount] = color;
+                        index = paletteCount++;
+                    }
+                    lastColor = color;
+                    lastIndex = index;
+                }
+                dst[x >> 1] |= (x & 1) ? (uint8_t)index : (uint8_t)(index << 4);
+            }
+        }
+
+        out.pixels = std::move(packed);
+        out.rowBytes = rowBytes;
+        out.palette = palette;
+        if (opaque) {
+            for (uint32_t& color : out.palette) {
+                color |= 0xff000000;
+            }
+        }
+        return true;
+    }
+}
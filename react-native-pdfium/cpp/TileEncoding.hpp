@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "fpdfview.h"
+
+namespace margelo::nitro::pdfium {
+
+    // Number of entries of a 4-bit palette
+    static constexpr int kPaletteSize = 16;
+
+    // A tile packed as 4-bit palette indices, two pixels per byte with the left pixel in the
+    // high nibble. Palette entries are 4-byte colors in the byte order of the source pixels.
+    struct Palette4Tile {
+        std::vector<uint8_t> pixels;
+        int rowBytes = 0;
+        std::array<uint32_t, kPaletteSize> palette{};
+    };
+
+    // Returns true if every pixel of a 1- or 4-byte-per-pixel tile has the same value, ignoring
+    // the padding byte of opaque formats. `pixel` receives that value as laid out in memory.
+    bool findUniformPixel(const uint8_t* pixels, int width, int height, int stride, int bytesPerPixel, bool opaque, uint32_t& pixel);
+
+    // Renders a small thumbnail of the page and reports whether all of its content is
+    // (nearly) gray, so tiles of the page can be rendered as Gray8 without visible loss.
+    bool isGrayscalePage(FPDF_PAGE page);
+
+    // Quantizes a Gray8 tile to 16 gray levels. Palette entries are opaque gray in any
+    // 4-byte order.
+    Palette4Tile packGrayToPalette4(const uint8_t* gray, int width, int height, int stride);
+
+    // Packs a 4-byte-per-pixel tile losslessly if it uses at most 16 distinct colors.
+    // Returns false, leaving `out` untouched, when there are more.
+    bool tryPackColorToPalette4(const uint8_t* pixels, int width, int height, int stride, bool opaque, Palette4Tile& out);
+}
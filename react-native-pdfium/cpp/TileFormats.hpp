@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include "fpdfview.h"
+#include "PixelFormat.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // How a tile of a given PixelFormat is rasterized by PDFium
+    struct TileFormatSpec {
+        int bitmapFormat;   // FPDFBitmap_* format handed to FPDFBitmap_CreateEx
+        int bytesPerPixel;
+        int renderFlags;    // Extra FPDF_* render flags needed to produce the layout
+        bool opaque;        // The fourth byte is padding rather than alpha
+    };
+
+    // PDFium natively writes BGR(A/x). FPDF_REVERSE_BYTE_ORDER makes it swap R and B while
+    // rasterizing, so RGBA consumers such as Skia's RGBA_8888 / RGB_888x can take the
+    // buffer as-is. The x formats render into an opaque bitmap, which also lets PDFium skip
+    // alpha blending against the background.
+    inline TileFormatSpec getTileFormatSpec(PixelFormat format) {
+        switch (format) {
+            case PixelFormat::RGBA: return {FPDFBitmap_BGRA, 4, FPDF_REVERSE_BYTE_ORDER, false};
+            case PixelFormat::BGRX: return {FPDFBitmap_BGRx, 4, 0, true};
+            case PixelFormat::RGBX: return {FPDFBitmap_BGRx, 4, FPDF_REVERSE_BYTE_ORDER, true};
+            case PixelFormat::BGRA:
+            default: return {FPDFBitmap_BGRA, 4, 0, false};
+        }
+    }
+
+    // Converts between a 0xAARRGGBB color and the pixel it is stored as in a tile of a format.
+    // FPDFBitmap_FillRect writes colors as BGRA whatever the render flags, so fills for the
+    // FPDF_REVERSE_BYTE_ORDER formats go through this too. Swapping R and B is its own inverse.
+    inline uint32_t toFormatByteOrder(uint32_t color, int renderFlags) {
+        if (!(renderFlags & FPDF_REVERSE_BYTE_ORDER)) {
+            return color;
+        }
+        return (color & 0xff00ff00) | ((color & 0xff) << 16) | ((color >> 16) & 0xff);
+    }
+}
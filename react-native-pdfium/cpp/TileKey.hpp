@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace margelo::nitro::pdfium {
+
+    // Identifies a rendered tile: the page region and everything that changes its pixels
+    struct TileKey {
+        int page = 0;
+        double row = 0;
+        double column = 0;
+        int width = 0;
+        int height = 0;
+        double scale = 0;
+        int pixelFormat = 0;
+        int colorMode = 0;
+        int quality = 0;
+        uint64_t colorScheme = 0;
+
+        bool operator==(const TileKey& other) const {
+            return page == other.page && row == other.row && column == other.column &&
+                   width == other.width && height == other.height && scale == other.scale &&
+                   pixelFormat == other.pixelFormat && colorMode == other.colorMode &&
+                   quality == other.quality && colorScheme == other.colorScheme;
+        }
+    };
+}
+
+template <>
+struct std::hash<margelo::nitro::pdfium::TileKey> {
+    size_t operator()(const margelo::nitro::pdfium::TileKey& key) const {
+        size_t hash = std::hash<int>()(key.page);
+        auto combine = [&hash](size_t value) {
+            hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        };
+        combine(std::hash<double>()(key.row));
+        combine(std::hash<double>()(key.column));
+        combine(std::hash<int>()(key.width));
+        combine(std::hash<int>()(key.height));
+        combine(std::hash<double>()(key.scale));
+        combine(std::hash<int>()(key.pixelFormat));
+        combine(std::hash<int>()(key.colorMode));
+        combine(std::hash<int>()(key.quality));
+        combine(std::hash<uint64_t>()(key.colorScheme));
+        return hash;
+    }
+};
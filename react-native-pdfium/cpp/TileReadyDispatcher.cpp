@@ -0,0 +1,72 @@
+#include "TileReadyDispatcher.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // 60 Hz when no interval is given
+    static constexpr double kDefaultFrameIntervalMs = 1000.0 / 60;
+
+    void TileReadyDispatcher::setListener(Listener listener, double frameIntervalMs) {
+        stop();
+        if (!listener) {
+            return;
+        }
+        double intervalMs = frameIntervalMs > 0 ? frameIntervalMs : kDefaultFrameIntervalMs;
+        m_listener = std::move(listener);
+        m_stopRequested = false;
+        m_pending.store(false);
+        if (++m_lastGeneration == 0) {
+            m_lastGeneration = 1;
+        }
+        m_generation.store(m_lastGeneration);
+        m_thread = std::thread(&TileReadyDispatcher::run, this,
+                               std::chrono::microseconds((long long)(intervalMs * 1000)), m_lastGeneration);
+    }
+
+    void TileReadyDispatcher::stop() {
+        m_generation.store(0);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = true;
+        }
+        m_condition.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        // Tiles completed after the last frame have no one to go to
+        std::vector<Queued> dropped;
+        m_queue.drain(dropped);
+        m_listener = nullptr;
+    }
+
+    void TileReadyDispatcher::run(std::chrono::microseconds interval, uint32_t generation) {
+        std::vector<Queued> queued;
+        std::vector<ReadyTile> tiles;
+        auto nextFrame = std::chrono::steady_clock::now() + interval;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopRequested || m_pending.load(); });
+                if (m_stopRequested ||
+                    m_condition.wait_until(lock, nextFrame, [this] { return m_stopRequested; })) {
+                    return;
+                }
+            }
+            // Frames missed while the listener ran or while idle are skipped rather than caught up on
+            nextFrame = std::chrono::steady_clock::now() + interval;
+
+            // Cleared before draining, so a tile pushed meanwhile always wakes the next frame
+            m_pending.store(false);
+            queued.clear();
+            tiles.clear();
+            m_queue.drain(queued);
+            for (Queued& entry : queued) {
+                if (entry.generation == generation) {
+                    tiles.push_back(std::move(entry.tile));
+                }
+            }
+            if (!tiles.empty()) {
+                m_listener(tiles);
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "MpscQueue.hpp"
+#include "ReadyTile.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    // Batches finished tiles into one listener call per frame. Render threads push without
+    // locking, except to wake the dispatcher thread when the first tile of a frame arrives. It
+    // then waits for the frame boundary and hands everything that completed in that frame to
+    // the listener at once, and sleeps while no tiles complete.
+    class TileReadyDispatcher {
+        public:
+            using Listener = std::function<void(const std::vector<ReadyTile>& tiles)>;
+
+            TileReadyDispatcher() = default;
+            ~TileReadyDispatcher() { stop(); }
+
+            // Starts dispatching to `listener` every frameIntervalMs, replacing any previous one
+            void setListener(Listener listener, double frameIntervalMs);
+            // Ignored while no listener is set
+            void push(ReadyTile tile) {
+                uint32_t generation = m_generation.load(std::memory_order_relaxed);
+                if (generation == 0) {
+                    return;
+                }
+                m_queue.push(Queued{generation, std::move(tile)});
+                if (!m_pending.exchange(true)) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_condition.notify_one();
+                }
+            }
+            void stop();
+
+        private:
+            // Tiles are tagged with the listener they were pushed for. A push racing stop() can
+            // land after it drained the queue, and must not reach the next listener.
+            struct Queued {
+                uint32_t generation;
+                ReadyTile tile;
+            };
+
+            void run(std::chrono::microseconds interval, uint32_t generation);
+
+            MpscQueue<Queued> m_queue;
+            Listener m_listener; // Only touched by the dispatcher thread while it runs
+            std::thread m_thread;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            bool m_stopRequested = false;
+            std::atomic<uint32_t> m_generation{0}; // Of the current listener, 0 while there is none
+            uint32_t m_lastGeneration = 0;
+            std::atomic<bool> m_pending{false}; // Tiles were pushed since the last drain
+    };
+}
@@ -0,0 +1,100 @@
+#include "TileUpgrader.hpp"
+#include <algorithm>
+#include <optional>
+
+namespace margelo::nitro::pdfium {
+
+    // Older drafts have long scrolled out of view
+    static constexpr size_t kMaxPendingUpgrades = 256;
+
+    void TileUpgrader::addDraft(const TileKey& key, const TileRequest& fullRequest, int documentId, double draftMs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.draftTiles++;
+        m_stats.draftRenderMs += draftMs;
+        if (!m_pendingKeys.insert(key).second) {
+            return;
+        }
+        m_pending.push_back(Draft{key, fullRequest, documentId, draftMs});
+        if (m_pending.size() > kMaxPendingUpgrades) {
+            m_pendingKeys.erase(m_pending.front().key);
+            m_pending.pop_front();
+        }
+
+        if (!m_thread.joinable()) {
+            m_stopRequested = false;
+            m_thread = std::thread(&TileUpgrader::run, this);
+        }
+        m_condition.notify_one();
+    }
+
+    void TileUpgrader::setMoving(bool moving) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_moving = moving;
+        }
+        m_condition.notify_one();
+    }
+
+    void TileUpgrader::setListener(UpgradedCallback listener) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_listener = std::move(listener);
+    }
+
+    TileUpgradeStats TileUpgrader::getStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TileUpgradeStats stats = m_stats;
+        stats.pendingUpgrades = (int)m_pending.size();
+        return stats;
+    }
+
+    void TileUpgrader::cancel() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.clear();
+        m_pendingKeys.clear();
+    }
+
+    void TileUpgrader::stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.clear();
+            m_pendingKeys.clear();
+            m_stopRequested = true;
+        }
+        m_condition.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void TileUpgrader::run() {
+        while (true) {
+            std::optional<Draft> draft;
+            UpgradedCallback listener;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopRequested || (!m_moving && !m_pending.empty()); });
+                if (m_stopRequested) {
+                    return;
+                }
+                draft.emplace(std::move(m_pending.back()));
+                m_pending.pop_back();
+                m_pendingKeys.erase(draft->key);
+                listener = m_listener;
+            }
+
+            double fullMs = m_renderer(draft->request, draft->documentId);
+            if (fullMs < 0) {
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stats.upgradedTiles++;
+                m_stats.upgradeRenderMs += fullMs;
+                m_stats.savedMs += std::max(fullMs - draft->draftMs, 0.0);
+            }
+            if (listener) {
+                listener(draft->request);
+            }
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include "TileKey.hpp"
+#include "TileRequest.hpp"
+
+namespace margelo::nitro::pdfium {
+
+    struct TileUpgradeStats {
+        int draftTiles = 0;        // Draft renders
+        int upgradedTiles = 0;     // Drafts re-rendered at full quality
+        int pendingUpgrades = 0;
+        double draftRenderMs = 0;  // Total time of all draft renders
+        double upgradeRenderMs = 0;
+        double savedMs = 0;        // Full minus draft render time of the upgraded tiles
+    };
+
+    // Re-renders draft tiles at full quality on a worker thread while the viewer is at rest.
+    // Drafts are upgraded newest first since those are the ones on screen. Rendering pauses as
+    // soon as motion resumes and continues where it left off once it stops again.
+    class TileUpgrader {
+        public:
+            // Renders the full quality tile for the request and returns the time it took in ms,
+            // or a negative value if the document the draft was made for is no longer open.
+            // Called on the worker thread.
+            using Renderer = std::function<double(const TileRequest& request, int documentId)>;
+            using UpgradedCallback = std::function<void(const TileRequest& request)>;
+
+            explicit TileUpgrader(Renderer renderer) : m_renderer(std::move(renderer)) {}
+            ~TileUpgrader() { stop(); }
+
+            // Records a draft render of `fullRequest` that took `draftMs`
+            void addDraft(const TileKey& key, const TileRequest& fullRequest, int documentId, double draftMs);
+            void setMoving(bool moving);
+            void setListener(UpgradedCallback listener);
+            TileUpgradeStats getStats();
+            // Drops pending upgrades, e.g. when the document changes
+            void cancel();
+            void stop();
+
+        private:
+            struct Draft {
+                TileKey key;
+                TileRequest request;
+                int documentId;
+                double draftMs;
+            };
+
+            void run();
+
+            Renderer m_renderer;
+            UpgradedCallback m_listener;
+            std::thread m_thread;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::deque<Draft> m_pending;          // Newest at the back
+            std::unordered_set<TileKey> m_pendingKeys;
+            bool m_moving = false;
+            bool m_stopRequested = false;
+            TileUpgradeStats m_stats;
+    };
+}
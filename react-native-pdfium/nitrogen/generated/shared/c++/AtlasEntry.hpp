@@ -0,0 +1,85 @@
+///
+/// AtlasEntry.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (AtlasEntry).
+   */
+  struct AtlasEntry {
+  public:
+    double slot     SWIFT_PRIVATE;
+    double x     SWIFT_PRIVATE;
+    double y     SWIFT_PRIVATE;
+    double width     SWIFT_PRIVATE;
+    double height     SWIFT_PRIVATE;
+    bool rendered     SWIFT_PRIVATE;
+
+  public:
+    explicit AtlasEntry(double slot, double x, double y, double width, double height, bool rendered): slot(slot), x(x), y(y), width(width), height(height), rendered(rendered) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ AtlasEntry <> JS AtlasEntry (object)
+  template <>
+  struct JSIConverter<AtlasEntry> {
+    static inline AtlasEntry fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return AtlasEntry(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "slot")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "x")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "y")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "width")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "height")),
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, "rendered"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const AtlasEntry& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "slot", JSIConverter<double>::toJSI(runtime, arg.slot));
+      obj.setProperty(runtime, "x", JSIConverter<double>::toJSI(runtime, arg.x));
+      obj.setProperty(runtime, "y", JSIConverter<double>::toJSI(runtime, arg.y));
+      obj.setProperty(runtime, "width", JSIConverter<double>::toJSI(runtime, arg.width));
+      obj.setProperty(runtime, "height", JSIConverter<double>::toJSI(runtime, arg.height));
+      obj.setProperty(runtime, "rendered", JSIConverter<bool>::toJSI(runtime, arg.rendered));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "slot"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "x"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "y"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "width"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "height"))) return false;
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, "rendered"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
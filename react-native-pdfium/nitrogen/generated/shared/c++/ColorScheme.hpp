@@ -0,0 +1,81 @@
+///
+/// ColorScheme.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ColorScheme).
+   */
+  struct ColorScheme {
+  public:
+    double pathFillColor     SWIFT_PRIVATE;
+    double pathStrokeColor     SWIFT_PRIVATE;
+    double textFillColor     SWIFT_PRIVATE;
+    double textStrokeColor     SWIFT_PRIVATE;
+    double backgroundColor     SWIFT_PRIVATE;
+
+  public:
+    explicit ColorScheme(double pathFillColor, double pathStrokeColor, double textFillColor, double textStrokeColor, double backgroundColor): pathFillColor(pathFillColor), pathStrokeColor(pathStrokeColor), textFillColor(textFillColor), textStrokeColor(textStrokeColor), backgroundColor(backgroundColor) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ ColorScheme <> JS ColorScheme (object)
+  template <>
+  struct JSIConverter<ColorScheme> {
+    static inline ColorScheme fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ColorScheme(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pathFillColor")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pathStrokeColor")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "textFillColor")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "textStrokeColor")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "backgroundColor"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ColorScheme& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "pathFillColor", JSIConverter<double>::toJSI(runtime, arg.pathFillColor));
+      obj.setProperty(runtime, "pathStrokeColor", JSIConverter<double>::toJSI(runtime, arg.pathStrokeColor));
+      obj.setProperty(runtime, "textFillColor", JSIConverter<double>::toJSI(runtime, arg.textFillColor));
+      obj.setProperty(runtime, "textStrokeColor", JSIConverter<double>::toJSI(runtime, arg.textStrokeColor));
+      obj.setProperty(runtime, "backgroundColor", JSIConverter<double>::toJSI(runtime, arg.backgroundColor));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pathFillColor"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pathStrokeColor"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "textFillColor"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "textStrokeColor"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "backgroundColor"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -17,10 +17,49 @@ namespace margelo::nitro::pdfium {
       prototype.registerHybridMethod("add", &HybridPdfiumUtilSpec::add);
       prototype.registerHybridMethod("openPdf", &HybridPdfiumUtilSpec::openPdf);
       prototype.registerHybridMethod("closePdf", &HybridPdfiumUtilSpec::closePdf);
+      prototype.registerHybridMethod("openPdfAsync", &HybridPdfiumUtilSpec::openPdfAsync);
+      prototype.registerHybridMethod("getOpenTimings", &HybridPdfiumUtilSpec::getOpenTimings);
       prototype.registerHybridMethod("getTile", &HybridPdfiumUtilSpec::getTile);
+      prototype.registerHybridMethod("getTileInto", &HybridPdfiumUtilSpec::getTileInto);
       prototype.registerHybridMethod("getTileBgr565", &HybridPdfiumUtilSpec::getTileBgr565);
+      prototype.registerHybridMethod("renderTile", &HybridPdfiumUtilSpec::renderTile);
+      prototype.registerHybridMethod("setViewportOptions", &HybridPdfiumUtilSpec::setViewportOptions);
+      prototype.registerHybridMethod("getPageGeometry", &HybridPdfiumUtilSpec::getPageGeometry);
+      prototype.registerHybridMethod("getPageRange", &HybridPdfiumUtilSpec::getPageRange);
+      prototype.registerHybridMethod("getLayoutSize", &HybridPdfiumUtilSpec::getLayoutSize);
+      prototype.registerHybridMethod("getFitWidthScale", &HybridPdfiumUtilSpec::getFitWidthScale);
+      prototype.registerHybridMethod("getVisiblePages", &HybridPdfiumUtilSpec::getVisiblePages);
+      prototype.registerHybridMethod("renderViewport", &HybridPdfiumUtilSpec::renderViewport);
+      prototype.registerHybridMethod("renderGridTile", &HybridPdfiumUtilSpec::renderGridTile);
+      prototype.registerHybridMethod("configureAtlas", &HybridPdfiumUtilSpec::configureAtlas);
+      prototype.registerHybridMethod("renderAtlasBatch", &HybridPdfiumUtilSpec::renderAtlasBatch);
+      prototype.registerHybridMethod("setLargePageMode", &HybridPdfiumUtilSpec::setLargePageMode);
+      prototype.registerHybridMethod("setInteractionState", &HybridPdfiumUtilSpec::setInteractionState);
+      prototype.registerHybridMethod("setTileUpgradeListener", &HybridPdfiumUtilSpec::setTileUpgradeListener);
+      prototype.registerHybridMethod("getRenderQualityStats", &HybridPdfiumUtilSpec::getRenderQualityStats);
+      prototype.registerHybridMethod("scheduleRender", &HybridPdfiumUtilSpec::scheduleRender);
+      prototype.registerHybridMethod("setTilesReadyListener", &HybridPdfiumUtilSpec::setTilesReadyListener);
+      prototype.registerHybridMethod("cancelRender", &HybridPdfiumUtilSpec::cancelRender);
+      prototype.registerHybridMethod("getRenderSchedulerStats", &HybridPdfiumUtilSpec::getRenderSchedulerStats);
+      prototype.registerHybridMethod("getTileCacheStats", &HybridPdfiumUtilSpec::getTileCacheStats);
+      prototype.registerHybridMethod("setDiskCacheDirectory", &HybridPdfiumUtilSpec::setDiskCacheDirectory);
       prototype.registerHybridMethod("getPageCount", &HybridPdfiumUtilSpec::getPageCount);
       prototype.registerHybridMethod("getAllPageDimensions", &HybridPdfiumUtilSpec::getAllPageDimensions);
+      prototype.registerHybridMethod("setSidecarDirectory", &HybridPdfiumUtilSpec::setSidecarDirectory);
+      prototype.registerHybridMethod("getOutline", &HybridPdfiumUtilSpec::getOutline);
+      prototype.registerHybridMethod("getPageLabel", &HybridPdfiumUtilSpec::getPageLabel);
+      prototype.registerHybridMethod("getNamedDestinationPage", &HybridPdfiumUtilSpec::getNamedDestinationPage);
+      prototype.registerHybridMethod("startTextIndex", &HybridPdfiumUtilSpec::startTextIndex);
+      prototype.registerHybridMethod("getTextIndexProgress", &HybridPdfiumUtilSpec::getTextIndexProgress);
+      prototype.registerHybridMethod("searchTextIndex", &HybridPdfiumUtilSpec::searchTextIndex);
+      prototype.registerHybridMethod("getTextRects", &HybridPdfiumUtilSpec::getTextRects);
+      prototype.registerHybridMethod("searchAsync", &HybridPdfiumUtilSpec::searchAsync);
+      prototype.registerHybridMethod("cancelSearch", &HybridPdfiumUtilSpec::cancelSearch);
+      prototype.registerHybridMethod("getCharIndexAtPos", &HybridPdfiumUtilSpec::getCharIndexAtPos);
+      prototype.registerHybridMethod("getCharRangesInRect", &HybridPdfiumUtilSpec::getCharRangesInRect);
+      prototype.registerHybridMethod("getWordAt", &HybridPdfiumUtilSpec::getWordAt);
+      prototype.registerHybridMethod("getLinesInRect", &HybridPdfiumUtilSpec::getLinesInRect);
+      prototype.registerHybridMethod("hitTest", &HybridPdfiumUtilSpec::hitTest);
     });
   }
 
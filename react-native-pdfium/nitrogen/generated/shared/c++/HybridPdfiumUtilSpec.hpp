@@ -13,13 +13,63 @@
 #error NitroModules cannot be found! Are you sure you installed NitroModules properly?
 #endif
 
+// Forward declaration of `TileRequest` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct TileRequest; }
+// Forward declaration of `RenderedTile` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct RenderedTile; }
+// Forward declaration of `OpenTimings` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct OpenTimings; }
 // Forward declaration of `ArrayBuffer` to properly resolve imports.
 namespace NitroModules { class ArrayBuffer; }
+// Forward declaration of `PixelFormat` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class PixelFormat; }
+// Forward declaration of `ViewportOptions` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct ViewportOptions; }
+// Forward declaration of `ViewportTile` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct ViewportTile; }
+// Forward declaration of `AtlasEntry` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct AtlasEntry; }
+// Forward declaration of `RenderQualityStats` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct RenderQualityStats; }
+// Forward declaration of `RenderPriority` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class RenderPriority; }
+// Forward declaration of `ReadyTile` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct ReadyTile; }
+// Forward declaration of `RenderSchedulerStats` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct RenderSchedulerStats; }
+// Forward declaration of `TileCacheStats` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct TileCacheStats; }
+// Forward declaration of `OutlineItem` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct OutlineItem; }
+// Forward declaration of `TextRange` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct TextRange; }
+// Forward declaration of `TextSegment` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct TextSegment; }
+// Forward declaration of `PageElement` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct PageElement; }
 
 #include <string>
-#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+#include "TileRequest.hpp"
+#include <functional>
+#include "RenderedTile.hpp"
 #include <vector>
+#include "OpenTimings.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include "PixelFormat.hpp"
+#include "ViewportOptions.hpp"
+#include "ViewportTile.hpp"
+#include "AtlasEntry.hpp"
+#include "RenderQualityStats.hpp"
+#include "RenderPriority.hpp"
+#include "ReadyTile.hpp"
+#include "RenderSchedulerStats.hpp"
+#include "TileCacheStats.hpp"
 #include <tuple>
+#include "OutlineItem.hpp"
+#include "TextRange.hpp"
+#include "TextSegment.hpp"
+#include "PageElement.hpp"
 
 namespace margelo::nitro::pdfium {
 
@@ -55,10 +105,49 @@ namespace margelo::nitro::pdfium {
       virtual double add(double a, double b) = 0;
       virtual void openPdf(const std::string& filePath) = 0;
       virtual void closePdf() = 0;
-      virtual std::shared_ptr<ArrayBuffer> getTile(double pageNumber, double row, double column, double displayWidth, double tileWidth, double tileHeight, double scale) = 0;
+      virtual void openPdfAsync(const std::string& filePath, const std::optional<TileRequest>& initialTile, const std::function<void(double /* pageCount */, const std::optional<RenderedTile>& /* firstTile */)>& onOpened, const std::function<void(double /* firstPage */, const std::vector<double>& /* sizes */, bool /* done */)>& onPageSizes) = 0;
+      virtual OpenTimings getOpenTimings() = 0;
+      virtual std::shared_ptr<ArrayBuffer> getTile(double pageNumber, double row, double column, double displayWidth, double tileWidth, double tileHeight, double scale, PixelFormat pixelFormat) = 0;
+      virtual bool getTileInto(const std::shared_ptr<ArrayBuffer>& target, double offset, double rowBytes, double pageNumber, double row, double column, double tileWidth, double tileHeight, double scale, PixelFormat pixelFormat) = 0;
       virtual std::shared_ptr<ArrayBuffer> getTileBgr565(double pageNumber, double row, double column, double displayWidth, double tileWidth, double tileHeight, double scale) = 0;
+      virtual RenderedTile renderTile(const TileRequest& request) = 0;
+      virtual void setViewportOptions(const ViewportOptions& options) = 0;
+      virtual std::shared_ptr<ArrayBuffer> getPageGeometry(double firstPage, double count) = 0;
+      virtual std::vector<double> getPageRange(double start, double end) = 0;
+      virtual std::vector<double> getLayoutSize() = 0;
+      virtual double getFitWidthScale(double viewportWidth) = 0;
+      virtual std::vector<double> getVisiblePages(double offsetX, double offsetY, double scale, double width, double height) = 0;
+      virtual std::vector<ViewportTile> renderViewport(double offsetX, double offsetY, double scale, double width, double height) = 0;
+      virtual RenderedTile renderGridTile(double x, double y, double scale, double gapColor) = 0;
+      virtual std::shared_ptr<ArrayBuffer> configureAtlas(double slotSize, double columns, double rows, PixelFormat pixelFormat) = 0;
+      virtual std::vector<AtlasEntry> renderAtlasBatch(const std::vector<TileRequest>& requests) = 0;
+      virtual void setLargePageMode(bool enabled) = 0;
+      virtual void setInteractionState(bool moving) = 0;
+      virtual void setTileUpgradeListener(const std::function<void(const TileRequest& /* request */)>& onUpgraded) = 0;
+      virtual RenderQualityStats getRenderQualityStats() = 0;
+      virtual double scheduleRender(const TileRequest& request, RenderPriority priority, double deadlineMs, const std::optional<std::function<void(const std::optional<RenderedTile>& /* tile */)>>& onRendered) = 0;
+      virtual void setTilesReadyListener(const std::function<void(const std::vector<ReadyTile>& /* tiles */)>& onTilesReady, double frameIntervalMs) = 0;
+      virtual bool cancelRender(double id) = 0;
+      virtual RenderSchedulerStats getRenderSchedulerStats() = 0;
+      virtual TileCacheStats getTileCacheStats() = 0;
+      virtual bool setDiskCacheDirectory(const std::string& directory, double maxBytes) = 0;
       virtual double getPageCount() = 0;
       virtual std::vector<std::tuple<double, double, double>> getAllPageDimensions() = 0;
+      virtual void setSidecarDirectory(const std::string& directory) = 0;
+      virtual std::vector<OutlineItem> getOutline() = 0;
+      virtual std::string getPageLabel(double pageNumber) = 0;
+      virtual double getNamedDestinationPage(const std::string& name) = 0;
+      virtual void startTextIndex() = 0;
+      virtual double getTextIndexProgress() = 0;
+      virtual std::vector<TextRange> searchTextIndex(const std::string& query, double maxResults) = 0;
+      virtual std::vector<double> getTextRects(double pageNumber, double charIndex, double charCount) = 0;
+      virtual double searchAsync(const std::string& query, double flags, double startPage, double resultsPerBatch, const std::function<void(double /* searchId */, const std::vector<TextRange>& /* hits */, bool /* done */)>& onResults) = 0;
+      virtual void cancelSearch() = 0;
+      virtual double getCharIndexAtPos(double pageNumber, double x, double y, double tolerance) = 0;
+      virtual std::shared_ptr<ArrayBuffer> getCharRangesInRect(double pageNumber, double left, double top, double right, double bottom) = 0;
+      virtual std::optional<TextSegment> getWordAt(double pageNumber, double x, double y) = 0;
+      virtual std::vector<TextSegment> getLinesInRect(double pageNumber, double left, double top, double right, double bottom) = 0;
+      virtual std::optional<PageElement> hitTest(double pageNumber, double x, double y) = 0;
 
     protected:
       // Hybrid Setup
@@ -0,0 +1,82 @@
+///
+/// LayoutMode.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * An enum which can be represented as a JavaScript union (LayoutMode).
+   */
+  enum class LayoutMode {
+    VERTICAL      SWIFT_NAME(vertical) = 0,
+    HORIZONTAL      SWIFT_NAME(horizontal) = 1,
+    SPREAD      SWIFT_NAME(spread) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ LayoutMode <> JS LayoutMode (union)
+  template <>
+  struct JSIConverter<LayoutMode> {
+    static inline LayoutMode fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("vertical"): return LayoutMode::VERTICAL;
+        case hashString("horizontal"): return LayoutMode::HORIZONTAL;
+        case hashString("spread"): return LayoutMode::SPREAD;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum LayoutMode - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, LayoutMode arg) {
+      switch (arg) {
+        case LayoutMode::VERTICAL: return JSIConverter<std::string>::toJSI(runtime, "vertical");
+        case LayoutMode::HORIZONTAL: return JSIConverter<std::string>::toJSI(runtime, "horizontal");
+        case LayoutMode::SPREAD: return JSIConverter<std::string>::toJSI(runtime, "spread");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert LayoutMode to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("vertical"):
+        case hashString("horizontal"):
+        case hashString("spread"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
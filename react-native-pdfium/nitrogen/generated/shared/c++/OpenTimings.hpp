@@ -0,0 +1,77 @@
+///
+/// OpenTimings.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (OpenTimings).
+   */
+  struct OpenTimings {
+  public:
+    double loadMs     SWIFT_PRIVATE;
+    double firstPageMs     SWIFT_PRIVATE;
+    double firstTileMs     SWIFT_PRIVATE;
+    double geometryMs     SWIFT_PRIVATE;
+
+  public:
+    explicit OpenTimings(double loadMs, double firstPageMs, double firstTileMs, double geometryMs): loadMs(loadMs), firstPageMs(firstPageMs), firstTileMs(firstTileMs), geometryMs(geometryMs) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ OpenTimings <> JS OpenTimings (object)
+  template <>
+  struct JSIConverter<OpenTimings> {
+    static inline OpenTimings fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return OpenTimings(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "loadMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "firstPageMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "firstTileMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "geometryMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const OpenTimings& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "loadMs", JSIConverter<double>::toJSI(runtime, arg.loadMs));
+      obj.setProperty(runtime, "firstPageMs", JSIConverter<double>::toJSI(runtime, arg.firstPageMs));
+      obj.setProperty(runtime, "firstTileMs", JSIConverter<double>::toJSI(runtime, arg.firstTileMs));
+      obj.setProperty(runtime, "geometryMs", JSIConverter<double>::toJSI(runtime, arg.geometryMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "loadMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "firstPageMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "firstTileMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "geometryMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,74 @@
+///
+/// OutlineItem.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+#include <string>
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (OutlineItem).
+   */
+  struct OutlineItem {
+  public:
+    std::string title     SWIFT_PRIVATE;
+    double pageIndex     SWIFT_PRIVATE;
+    double depth     SWIFT_PRIVATE;
+
+  public:
+    explicit OutlineItem(std::string title, double pageIndex, double depth): title(title), pageIndex(pageIndex), depth(depth) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ OutlineItem <> JS OutlineItem (object)
+  template <>
+  struct JSIConverter<OutlineItem> {
+    static inline OutlineItem fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return OutlineItem(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "title")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pageIndex")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "depth"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const OutlineItem& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "title", JSIConverter<std::string>::toJSI(runtime, arg.title));
+      obj.setProperty(runtime, "pageIndex", JSIConverter<double>::toJSI(runtime, arg.pageIndex));
+      obj.setProperty(runtime, "depth", JSIConverter<double>::toJSI(runtime, arg.depth));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "title"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pageIndex"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "depth"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,102 @@
+///
+/// PageElement.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `PageElementKind` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class PageElementKind; }
+
+#include "PageElementKind.hpp"
+#include <string>
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PageElement).
+   */
+  struct PageElement {
+  public:
+    PageElementKind kind     SWIFT_PRIVATE;
+    double subtype     SWIFT_PRIVATE;
+    double annotIndex     SWIFT_PRIVATE;
+    double left     SWIFT_PRIVATE;
+    double top     SWIFT_PRIVATE;
+    double right     SWIFT_PRIVATE;
+    double bottom     SWIFT_PRIVATE;
+    double destPage     SWIFT_PRIVATE;
+    std::string uri     SWIFT_PRIVATE;
+
+  public:
+    explicit PageElement(PageElementKind kind, double subtype, double annotIndex, double left, double top, double right, double bottom, double destPage, std::string uri): kind(kind), subtype(subtype), annotIndex(annotIndex), left(left), top(top), right(right), bottom(bottom), destPage(destPage), uri(uri) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ PageElement <> JS PageElement (object)
+  template <>
+  struct JSIConverter<PageElement> {
+    static inline PageElement fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return PageElement(
+        JSIConverter<PageElementKind>::fromJSI(runtime, obj.getProperty(runtime, "kind")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "subtype")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "annotIndex")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "left")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "top")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "right")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bottom")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "destPage")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "uri"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const PageElement& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "kind", JSIConverter<PageElementKind>::toJSI(runtime, arg.kind));
+      obj.setProperty(runtime, "subtype", JSIConverter<double>::toJSI(runtime, arg.subtype));
+      obj.setProperty(runtime, "annotIndex", JSIConverter<double>::toJSI(runtime, arg.annotIndex));
+      obj.setProperty(runtime, "left", JSIConverter<double>::toJSI(runtime, arg.left));
+      obj.setProperty(runtime, "top", JSIConverter<double>::toJSI(runtime, arg.top));
+      obj.setProperty(runtime, "right", JSIConverter<double>::toJSI(runtime, arg.right));
+      obj.setProperty(runtime, "bottom", JSIConverter<double>::toJSI(runtime, arg.bottom));
+      obj.setProperty(runtime, "destPage", JSIConverter<double>::toJSI(runtime, arg.destPage));
+      obj.setProperty(runtime, "uri", JSIConverter<std::string>::toJSI(runtime, arg.uri));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<PageElementKind>::canConvert(runtime, obj.getProperty(runtime, "kind"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "subtype"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "annotIndex"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "left"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "top"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "right"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bottom"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "destPage"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "uri"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
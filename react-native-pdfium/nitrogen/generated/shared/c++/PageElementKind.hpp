@@ -0,0 +1,78 @@
+///
+/// PageElementKind.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * An enum which can be represented as a JavaScript union (PageElementKind).
+   */
+  enum class PageElementKind {
+    LINK      SWIFT_NAME(link) = 0,
+    ANNOTATION      SWIFT_NAME(annotation) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ PageElementKind <> JS PageElementKind (union)
+  template <>
+  struct JSIConverter<PageElementKind> {
+    static inline PageElementKind fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("link"): return PageElementKind::LINK;
+        case hashString("annotation"): return PageElementKind::ANNOTATION;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum PageElementKind - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, PageElementKind arg) {
+      switch (arg) {
+        case PageElementKind::LINK: return JSIConverter<std::string>::toJSI(runtime, "link");
+        case PageElementKind::ANNOTATION: return JSIConverter<std::string>::toJSI(runtime, "annotation");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert PageElementKind to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("link"):
+        case hashString("annotation"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,86 @@
+///
+/// PixelFormat.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * An enum which can be represented as a JavaScript union (PixelFormat).
+   */
+  enum class PixelFormat {
+    BGRA      SWIFT_NAME(bgra) = 0,
+    RGBA      SWIFT_NAME(rgba) = 1,
+    BGRX      SWIFT_NAME(bgrx) = 2,
+    RGBX      SWIFT_NAME(rgbx) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ PixelFormat <> JS PixelFormat (union)
+  template <>
+  struct JSIConverter<PixelFormat> {
+    static inline PixelFormat fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("bgra"): return PixelFormat::BGRA;
+        case hashString("rgba"): return PixelFormat::RGBA;
+        case hashString("bgrx"): return PixelFormat::BGRX;
+        case hashString("rgbx"): return PixelFormat::RGBX;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum PixelFormat - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, PixelFormat arg) {
+      switch (arg) {
+        case PixelFormat::BGRA: return JSIConverter<std::string>::toJSI(runtime, "bgra");
+        case PixelFormat::RGBA: return JSIConverter<std::string>::toJSI(runtime, "rgba");
+        case PixelFormat::BGRX: return JSIConverter<std::string>::toJSI(runtime, "bgrx");
+        case PixelFormat::RGBX: return JSIConverter<std::string>::toJSI(runtime, "rgbx");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert PixelFormat to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("bgra"):
+        case hashString("rgba"):
+        case hashString("bgrx"):
+        case hashString("rgbx"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
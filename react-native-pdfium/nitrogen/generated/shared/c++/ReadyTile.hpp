@@ -0,0 +1,80 @@
+///
+/// ReadyTile.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `TileRequest` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct TileRequest; }
+// Forward declaration of `RenderedTile` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct RenderedTile; }
+
+#include "TileRequest.hpp"
+#include "RenderedTile.hpp"
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ReadyTile).
+   */
+  struct ReadyTile {
+  public:
+    double id     SWIFT_PRIVATE;
+    TileRequest request     SWIFT_PRIVATE;
+    RenderedTile tile     SWIFT_PRIVATE;
+
+  public:
+    explicit ReadyTile(double id, TileRequest request, RenderedTile tile): id(id), request(request), tile(tile) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ ReadyTile <> JS ReadyTile (object)
+  template <>
+  struct JSIConverter<ReadyTile> {
+    static inline ReadyTile fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ReadyTile(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "id")),
+        JSIConverter<TileRequest>::fromJSI(runtime, obj.getProperty(runtime, "request")),
+        JSIConverter<RenderedTile>::fromJSI(runtime, obj.getProperty(runtime, "tile"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ReadyTile& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "id", JSIConverter<double>::toJSI(runtime, arg.id));
+      obj.setProperty(runtime, "request", JSIConverter<TileRequest>::toJSI(runtime, arg.request));
+      obj.setProperty(runtime, "tile", JSIConverter<RenderedTile>::toJSI(runtime, arg.tile));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "id"))) return false;
+      if (!JSIConverter<TileRequest>::canConvert(runtime, obj.getProperty(runtime, "request"))) return false;
+      if (!JSIConverter<RenderedTile>::canConvert(runtime, obj.getProperty(runtime, "tile"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,86 @@
+///
+/// RenderPriority.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * An enum which can be represented as a JavaScript union (RenderPriority).
+   */
+  enum class RenderPriority {
+    VISIBLE      SWIFT_NAME(visible) = 0,
+    HIGHLIGHT      SWIFT_NAME(highlight) = 1,
+    THUMBNAIL      SWIFT_NAME(thumbnail) = 2,
+    PREFETCH      SWIFT_NAME(prefetch) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ RenderPriority <> JS RenderPriority (union)
+  template <>
+  struct JSIConverter<RenderPriority> {
+    static inline RenderPriority fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("visible"): return RenderPriority::VISIBLE;
+        case hashString("highlight"): return RenderPriority::HIGHLIGHT;
+        case hashString("thumbnail"): return RenderPriority::THUMBNAIL;
+        case hashString("prefetch"): return RenderPriority::PREFETCH;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum RenderPriority - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, RenderPriority arg) {
+      switch (arg) {
+        case RenderPriority::VISIBLE: return JSIConverter<std::string>::toJSI(runtime, "visible");
+        case RenderPriority::HIGHLIGHT: return JSIConverter<std::string>::toJSI(runtime, "highlight");
+        case RenderPriority::THUMBNAIL: return JSIConverter<std::string>::toJSI(runtime, "thumbnail");
+        case RenderPriority::PREFETCH: return JSIConverter<std::string>::toJSI(runtime, "prefetch");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert RenderPriority to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("visible"):
+        case hashString("highlight"):
+        case hashString("thumbnail"):
+        case hashString("prefetch"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,85 @@
+///
+/// RenderQualityStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (RenderQualityStats).
+   */
+  struct RenderQualityStats {
+  public:
+    double draftTiles     SWIFT_PRIVATE;
+    double upgradedTiles     SWIFT_PRIVATE;
+    double pendingUpgrades     SWIFT_PRIVATE;
+    double draftRenderMs     SWIFT_PRIVATE;
+    double upgradeRenderMs     SWIFT_PRIVATE;
+    double savedMs     SWIFT_PRIVATE;
+
+  public:
+    explicit RenderQualityStats(double draftTiles, double upgradedTiles, double pendingUpgrades, double draftRenderMs, double upgradeRenderMs, double savedMs): draftTiles(draftTiles), upgradedTiles(upgradedTiles), pendingUpgrades(pendingUpgrades), draftRenderMs(draftRenderMs), upgradeRenderMs(upgradeRenderMs), savedMs(savedMs) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ RenderQualityStats <> JS RenderQualityStats (object)
+  template <>
+  struct JSIConverter<RenderQualityStats> {
+    static inline RenderQualityStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return RenderQualityStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "draftTiles")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "upgradedTiles")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pendingUpgrades")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "draftRenderMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "upgradeRenderMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "savedMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const RenderQualityStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "draftTiles", JSIConverter<double>::toJSI(runtime, arg.draftTiles));
+      obj.setProperty(runtime, "upgradedTiles", JSIConverter<double>::toJSI(runtime, arg.upgradedTiles));
+      obj.setProperty(runtime, "pendingUpgrades", JSIConverter<double>::toJSI(runtime, arg.pendingUpgrades));
+      obj.setProperty(runtime, "draftRenderMs", JSIConverter<double>::toJSI(runtime, arg.draftRenderMs));
+      obj.setProperty(runtime, "upgradeRenderMs", JSIConverter<double>::toJSI(runtime, arg.upgradeRenderMs));
+      obj.setProperty(runtime, "savedMs", JSIConverter<double>::toJSI(runtime, arg.savedMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "draftTiles"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "upgradedTiles"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pendingUpgrades"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "draftRenderMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "upgradeRenderMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "savedMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
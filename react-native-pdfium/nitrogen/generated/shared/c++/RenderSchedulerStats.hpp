@@ -0,0 +1,93 @@
+///
+/// RenderSchedulerStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (RenderSchedulerStats).
+   */
+  struct RenderSchedulerStats {
+  public:
+    double queueDepth     SWIFT_PRIVATE;
+    double visibleQueueDepth     SWIFT_PRIVATE;
+    double completed     SWIFT_PRIVATE;
+    double dropped     SWIFT_PRIVATE;
+    double downgraded     SWIFT_PRIVATE;
+    double averageWaitMs     SWIFT_PRIVATE;
+    double maxWaitMs     SWIFT_PRIVATE;
+    double averageVisibleWaitMs     SWIFT_PRIVATE;
+
+  public:
+    explicit RenderSchedulerStats(double queueDepth, double visibleQueueDepth, double completed, double dropped, double downgraded, double averageWaitMs, double maxWaitMs, double averageVisibleWaitMs): queueDepth(queueDepth), visibleQueueDepth(visibleQueueDepth), completed(completed), dropped(dropped), downgraded(downgraded), averageWaitMs(averageWaitMs), maxWaitMs(maxWaitMs), averageVisibleWaitMs(averageVisibleWaitMs) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ RenderSchedulerStats <> JS RenderSchedulerStats (object)
+  template <>
+  struct JSIConverter<RenderSchedulerStats> {
+    static inline RenderSchedulerStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return RenderSchedulerStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "queueDepth")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "visibleQueueDepth")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "completed")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "dropped")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "downgraded")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "averageWaitMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "maxWaitMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "averageVisibleWaitMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const RenderSchedulerStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "queueDepth", JSIConverter<double>::toJSI(runtime, arg.queueDepth));
+      obj.setProperty(runtime, "visibleQueueDepth", JSIConverter<double>::toJSI(runtime, arg.visibleQueueDepth));
+      obj.setProperty(runtime, "completed", JSIConverter<double>::toJSI(runtime, arg.completed));
+      obj.setProperty(runtime, "dropped", JSIConverter<double>::toJSI(runtime, arg.dropped));
+      obj.setProperty(runtime, "downgraded", JSIConverter<double>::toJSI(runtime, arg.downgraded));
+      obj.setProperty(runtime, "averageWaitMs", JSIConverter<double>::toJSI(runtime, arg.averageWaitMs));
+      obj.setProperty(runtime, "maxWaitMs", JSIConverter<double>::toJSI(runtime, arg.maxWaitMs));
+      obj.setProperty(runtime, "averageVisibleWaitMs", JSIConverter<double>::toJSI(runtime, arg.averageVisibleWaitMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "queueDepth"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "visibleQueueDepth"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "completed"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "dropped"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "downgraded"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "averageWaitMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "maxWaitMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "averageVisibleWaitMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
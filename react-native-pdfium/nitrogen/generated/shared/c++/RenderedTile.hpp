@@ -0,0 +1,104 @@
+///
+/// RenderedTile.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+// Forward declaration of `TileColorType` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class TileColorType; }
+// Forward declaration of `TileQuality` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class TileQuality; }
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include "TileColorType.hpp"
+#include <optional>
+#include "TileQuality.hpp"
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (RenderedTile).
+   */
+  struct RenderedTile {
+  public:
+    std::shared_ptr<ArrayBuffer> buffer     SWIFT_PRIVATE;
+    double width     SWIFT_PRIVATE;
+    double height     SWIFT_PRIVATE;
+    double rowBytes     SWIFT_PRIVATE;
+    TileColorType colorType     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> palette     SWIFT_PRIVATE;
+    std::optional<double> uniformColor     SWIFT_PRIVATE;
+    TileQuality quality     SWIFT_PRIVATE;
+
+  public:
+    explicit RenderedTile(std::shared_ptr<ArrayBuffer> buffer, double width, double height, double rowBytes, TileColorType colorType, std::optional<std::shared_ptr<ArrayBuffer>> palette, std::optional<double> uniformColor, TileQuality quality): buffer(buffer), width(width), height(height), rowBytes(rowBytes), colorType(colorType), palette(palette), uniformColor(uniformColor), quality(quality) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ RenderedTile <> JS RenderedTile (object)
+  template <>
+  struct JSIConverter<RenderedTile> {
+    static inline RenderedTile fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return RenderedTile(
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "buffer")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "width")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "height")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "rowBytes")),
+        JSIConverter<TileColorType>::fromJSI(runtime, obj.getProperty(runtime, "colorType")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "palette")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "uniformColor")),
+        JSIConverter<TileQuality>::fromJSI(runtime, obj.getProperty(runtime, "quality"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const RenderedTile& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "buffer", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.buffer));
+      obj.setProperty(runtime, "width", JSIConverter<double>::toJSI(runtime, arg.width));
+      obj.setProperty(runtime, "height", JSIConverter<double>::toJSI(runtime, arg.height));
+      obj.setProperty(runtime, "rowBytes", JSIConverter<double>::toJSI(runtime, arg.rowBytes));
+      obj.setProperty(runtime, "colorType", JSIConverter<TileColorType>::toJSI(runtime, arg.colorType));
+      obj.setProperty(runtime, "palette", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.palette));
+      obj.setProperty(runtime, "uniformColor", JSIConverter<std::optional<double>>::toJSI(runtime, arg.uniformColor));
+      obj.setProperty(runtime, "quality", JSIConverter<TileQuality>::toJSI(runtime, arg.quality));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "buffer"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "width"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "height"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "rowBytes"))) return false;
+      if (!JSIConverter<TileColorType>::canConvert(runtime, obj.getProperty(runtime, "colorType"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "palette"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "uniformColor"))) return false;
+      if (!JSIConverter<TileQuality>::canConvert(runtime, obj.getProperty(runtime, "quality"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
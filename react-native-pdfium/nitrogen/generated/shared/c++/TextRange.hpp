@@ -0,0 +1,73 @@
+///
+/// TextRange.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TextRange).
+   */
+  struct TextRange {
+  public:
+    double page     SWIFT_PRIVATE;
+    double charIndex     SWIFT_PRIVATE;
+    double charCount     SWIFT_PRIVATE;
+
+  public:
+    explicit TextRange(double page, double charIndex, double charCount): page(page), charIndex(charIndex), charCount(charCount) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ TextRange <> JS TextRange (object)
+  template <>
+  struct JSIConverter<TextRange> {
+    static inline TextRange fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TextRange(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "page")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "charIndex")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "charCount"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TextRange& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "page", JSIConverter<double>::toJSI(runtime, arg.page));
+      obj.setProperty(runtime, "charIndex", JSIConverter<double>::toJSI(runtime, arg.charIndex));
+      obj.setProperty(runtime, "charCount", JSIConverter<double>::toJSI(runtime, arg.charCount));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "page"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "charIndex"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "charCount"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,85 @@
+///
+/// TextSegment.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TextSegment).
+   */
+  struct TextSegment {
+  public:
+    double charIndex     SWIFT_PRIVATE;
+    double charCount     SWIFT_PRIVATE;
+    double left     SWIFT_PRIVATE;
+    double top     SWIFT_PRIVATE;
+    double right     SWIFT_PRIVATE;
+    double bottom     SWIFT_PRIVATE;
+
+  public:
+    explicit TextSegment(double charIndex, double charCount, double left, double top, double right, double bottom): charIndex(charIndex), charCount(charCount), left(left), top(top), right(right), bottom(bottom) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ TextSegment <> JS TextSegment (object)
+  template <>
+  struct JSIConverter<TextSegment> {
+    static inline TextSegment fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TextSegment(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "charIndex")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "charCount")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "left")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "top")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "right")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bottom"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TextSegment& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "charIndex", JSIConverter<double>::toJSI(runtime, arg.charIndex));
+      obj.setProperty(runtime, "charCount", JSIConverter<double>::toJSI(runtime, arg.charCount));
+      obj.setProperty(runtime, "left", JSIConverter<double>::toJSI(runtime, arg.left));
+      obj.setProperty(runtime, "top", JSIConverter<double>::toJSI(runtime, arg.top));
+      obj.setProperty(runtime, "right", JSIConverter<double>::toJSI(runtime, arg.right));
+      obj.setProperty(runtime, "bottom", JSIConverter<double>::toJSI(runtime, arg.bottom));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "charIndex"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "charCount"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "left"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "top"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "right"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bottom"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,121 @@
+///
+/// TileCacheStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TileCacheStats).
+   */
+  struct TileCacheStats {
+  public:
+    double hotTiles     SWIFT_PRIVATE;
+    double hotBytes     SWIFT_PRIVATE;
+    double compressedTiles     SWIFT_PRIVATE;
+    double compressedBytes     SWIFT_PRIVATE;
+    double uncompressedBytes     SWIFT_PRIVATE;
+    double hotHits     SWIFT_PRIVATE;
+    double compressedHits     SWIFT_PRIVATE;
+    double misses     SWIFT_PRIVATE;
+    double averageDecompressMs     SWIFT_PRIVATE;
+    double averageRenderMs     SWIFT_PRIVATE;
+    double diskTiles     SWIFT_PRIVATE;
+    double diskBytes     SWIFT_PRIVATE;
+    double diskHits     SWIFT_PRIVATE;
+    double coalescedRequests     SWIFT_PRIVATE;
+    double coalescedSavedMs     SWIFT_PRIVATE;
+
+  public:
+    explicit TileCacheStats(double hotTiles, double hotBytes, double compressedTiles, double compressedBytes, double uncompressedBytes, double hotHits, double compressedHits, double misses, double averageDecompressMs, double averageRenderMs, double diskTiles, double diskBytes, double diskHits, double coalescedRequests, double coalescedSavedMs): hotTiles(hotTiles), hotBytes(hotBytes), compressedTiles(compressedTiles), compressedBytes(compressedBytes), uncompressedBytes(uncompressedBytes), hotHits(hotHits), compressedHits(compressedHits), misses(misses), averageDecompressMs(averageDecompressMs), averageRenderMs(averageRenderMs), diskTiles(diskTiles), diskBytes(diskBytes), diskHits(diskHits), coalescedRequests(coalescedRequests), coalescedSavedMs(coalescedSavedMs) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ TileCacheStats <> JS TileCacheStats (object)
+  template <>
+  struct JSIConverter<TileCacheStats> {
+    static inline TileCacheStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TileCacheStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "hotTiles")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "hotBytes")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "compressedTiles")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "compressedBytes")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "uncompressedBytes")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "hotHits")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "compressedHits")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "misses")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "averageDecompressMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "averageRenderMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "diskTiles")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "diskBytes")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "diskHits")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "coalescedRequests")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "coalescedSavedMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TileCacheStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "hotTiles", JSIConverter<double>::toJSI(runtime, arg.hotTiles));
+      obj.setProperty(runtime, "hotBytes", JSIConverter<double>::toJSI(runtime, arg.hotBytes));
+      obj.setProperty(runtime, "compressedTiles", JSIConverter<double>::toJSI(runtime, arg.compressedTiles));
+      obj.setProperty(runtime, "compressedBytes", JSIConverter<double>::toJSI(runtime, arg.compressedBytes));
+      obj.setProperty(runtime, "uncompressedBytes", JSIConverter<double>::toJSI(runtime, arg.uncompressedBytes));
+      obj.setProperty(runtime, "hotHits", JSIConverter<double>::toJSI(runtime, arg.hotHits));
+      obj.setProperty(runtime, "compressedHits", JSIConverter<double>::toJSI(runtime, arg.compressedHits));
+      obj.setProperty(runtime, "misses", JSIConverter<double>::toJSI(runtime, arg.misses));
+      obj.setProperty(runtime, "averageDecompressMs", JSIConverter<double>::toJSI(runtime, arg.averageDecompressMs));
+      obj.setProperty(runtime, "averageRenderMs", JSIConverter<double>::toJSI(runtime, arg.averageRenderMs));
+      obj.setProperty(runtime, "diskTiles", JSIConverter<double>::toJSI(runtime, arg.diskTiles));
+      obj.setProperty(runtime, "diskBytes", JSIConverter<double>::toJSI(runtime, arg.diskBytes));
+      obj.setProperty(runtime, "diskHits", JSIConverter<double>::toJSI(runtime, arg.diskHits));
+      obj.setProperty(runtime, "coalescedRequests", JSIConverter<double>::toJSI(runtime, arg.coalescedRequests));
+      obj.setProperty(runtime, "coalescedSavedMs", JSIConverter<double>::toJSI(runtime, arg.coalescedSavedMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "hotTiles"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "hotBytes"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "compressedTiles"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "compressedBytes"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "uncompressedBytes"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "hotHits"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "compressedHits"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "misses"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "averageDecompressMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "averageRenderMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "diskTiles"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "diskBytes"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "diskHits"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "coalescedRequests"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "coalescedSavedMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,86 @@
+///
+/// TileColorMode.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * An enum which can be represented as a JavaScript union (TileColorMode).
+   */
+  enum class TileColorMode {
+    COLOR      SWIFT_NAME(color) = 0,
+    GRAY      SWIFT_NAME(gray) = 1,
+    PALETTE      SWIFT_NAME(palette) = 2,
+    AUTO      SWIFT_NAME(auto) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ TileColorMode <> JS TileColorMode (union)
+  template <>
+  struct JSIConverter<TileColorMode> {
+    static inline TileColorMode fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("color"): return TileColorMode::COLOR;
+        case hashString("gray"): return TileColorMode::GRAY;
+        case hashString("palette"): return TileColorMode::PALETTE;
+        case hashString("auto"): return TileColorMode::AUTO;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum TileColorMode - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, TileColorMode arg) {
+      switch (arg) {
+        case TileColorMode::COLOR: return JSIConverter<std::string>::toJSI(runtime, "color");
+        case TileColorMode::GRAY: return JSIConverter<std::string>::toJSI(runtime, "gray");
+        case TileColorMode::PALETTE: return JSIConverter<std::string>::toJSI(runtime, "palette");
+        case TileColorMode::AUTO: return JSIConverter<std::string>::toJSI(runtime, "auto");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert TileColorMode to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("color"):
+        case hashString("gray"):
+        case hashString("palette"):
+        case hashString("auto"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
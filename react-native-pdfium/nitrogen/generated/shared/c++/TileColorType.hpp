@@ -0,0 +1,94 @@
+///
+/// TileColorType.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * An enum which can be represented as a JavaScript union (TileColorType).
+   */
+  enum class TileColorType {
+    BGRA8888      SWIFT_NAME(bgra8888) = 0,
+    RGBA8888      SWIFT_NAME(rgba8888) = 1,
+    BGRX8888      SWIFT_NAME(bgrx8888) = 2,
+    RGBX8888      SWIFT_NAME(rgbx8888) = 3,
+    GRAY8      SWIFT_NAME(gray8) = 4,
+    PALETTE4      SWIFT_NAME(palette4) = 5,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ TileColorType <> JS TileColorType (union)
+  template <>
+  struct JSIConverter<TileColorType> {
+    static inline TileColorType fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("bgra8888"): return TileColorType::BGRA8888;
+        case hashString("rgba8888"): return TileColorType::RGBA8888;
+        case hashString("bgrx8888"): return TileColorType::BGRX8888;
+        case hashString("rgbx8888"): return TileColorType::RGBX8888;
+        case hashString("gray8"): return TileColorType::GRAY8;
+        case hashString("palette4"): return TileColorType::PALETTE4;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum TileColorType - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, TileColorType arg) {
+      switch (arg) {
+        case TileColorType::BGRA8888: return JSIConverter<std::string>::toJSI(runtime, "bgra8888");
+        case TileColorType::RGBA8888: return JSIConverter<std::string>::toJSI(runtime, "rgba8888");
+        case TileColorType::BGRX8888: return JSIConverter<std::string>::toJSI(runtime, "bgrx8888");
+        case TileColorType::RGBX8888: return JSIConverter<std::string>::toJSI(runtime, "rgbx8888");
+        case TileColorType::GRAY8: return JSIConverter<std::string>::toJSI(runtime, "gray8");
+        case TileColorType::PALETTE4: return JSIConverter<std::string>::toJSI(runtime, "palette4");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert TileColorType to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("bgra8888"):
+        case hashString("rgba8888"):
+        case hashString("bgrx8888"):
+        case hashString("rgbx8888"):
+        case hashString("gray8"):
+        case hashString("palette4"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,115 @@
+///
+/// TileRequest.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `PixelFormat` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class PixelFormat; }
+// Forward declaration of `TileColorMode` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class TileColorMode; }
+// Forward declaration of `TileQuality` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class TileQuality; }
+// Forward declaration of `ColorScheme` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct ColorScheme; }
+
+#include "PixelFormat.hpp"
+#include "TileColorMode.hpp"
+#include <optional>
+#include "TileQuality.hpp"
+#include "ColorScheme.hpp"
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TileRequest).
+   */
+  struct TileRequest {
+  public:
+    double pageNumber     SWIFT_PRIVATE;
+    double row     SWIFT_PRIVATE;
+    double column     SWIFT_PRIVATE;
+    double tileWidth     SWIFT_PRIVATE;
+    double tileHeight     SWIFT_PRIVATE;
+    double scale     SWIFT_PRIVATE;
+    PixelFormat pixelFormat     SWIFT_PRIVATE;
+    TileColorMode colorMode     SWIFT_PRIVATE;
+    std::optional<TileQuality> quality     SWIFT_PRIVATE;
+    std::optional<ColorScheme> colorScheme     SWIFT_PRIVATE;
+
+  public:
+    explicit TileRequest(double pageNumber, double row, double column, double tileWidth, double tileHeight, double scale, PixelFormat pixelFormat, TileColorMode colorMode, std::optional<TileQuality> quality, std::optional<ColorScheme> colorScheme): pageNumber(pageNumber), row(row), column(column), tileWidth(tileWidth), tileHeight(tileHeight), scale(scale), pixelFormat(pixelFormat), colorMode(colorMode), quality(quality), colorScheme(colorScheme) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ TileRequest <> JS TileRequest (object)
+  template <>
+  struct JSIConverter<TileRequest> {
+    static inline TileRequest fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TileRequest(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pageNumber")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "row")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "column")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "tileWidth")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "tileHeight")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "scale")),
+        JSIConverter<PixelFormat>::fromJSI(runtime, obj.getProperty(runtime, "pixelFormat")),
+        JSIConverter<TileColorMode>::fromJSI(runtime, obj.getProperty(runtime, "colorMode")),
+        JSIConverter<std::optional<TileQuality>>::fromJSI(runtime, obj.getProperty(runtime, "quality")),
+        JSIConverter<std::optional<ColorScheme>>::fromJSI(runtime, obj.getProperty(runtime, "colorScheme"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TileRequest& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "pageNumber", JSIConverter<double>::toJSI(runtime, arg.pageNumber));
+      obj.setProperty(runtime, "row", JSIConverter<double>::toJSI(runtime, arg.row));
+      obj.setProperty(runtime, "column", JSIConverter<double>::toJSI(runtime, arg.column));
+      obj.setProperty(runtime, "tileWidth", JSIConverter<double>::toJSI(runtime, arg.tileWidth));
+      obj.setProperty(runtime, "tileHeight", JSIConverter<double>::toJSI(runtime, arg.tileHeight));
+      obj.setProperty(runtime, "scale", JSIConverter<double>::toJSI(runtime, arg.scale));
+      obj.setProperty(runtime, "pixelFormat", JSIConverter<PixelFormat>::toJSI(runtime, arg.pixelFormat));
+      obj.setProperty(runtime, "colorMode", JSIConverter<TileColorMode>::toJSI(runtime, arg.colorMode));
+      obj.setProperty(runtime, "quality", JSIConverter<std::optional<TileQuality>>::toJSI(runtime, arg.quality));
+      obj.setProperty(runtime, "colorScheme", JSIConverter<std::optional<ColorScheme>>::toJSI(runtime, arg.colorScheme));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pageNumber"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "row"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "column"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "tileWidth"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "tileHeight"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "scale"))) return false;
+      if (!JSIConverter<PixelFormat>::canConvert(runtime, obj.getProperty(runtime, "pixelFormat"))) return false;
+      if (!JSIConverter<TileColorMode>::canConvert(runtime, obj.getProperty(runtime, "colorMode"))) return false;
+      if (!JSIConverter<std::optional<TileQuality>>::canConvert(runtime, obj.getProperty(runtime, "quality"))) return false;
+      if (!JSIConverter<std::optional<ColorScheme>>::canConvert(runtime, obj.getProperty(runtime, "colorScheme"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,99 @@
+///
+/// ViewportOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `LayoutMode` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class LayoutMode; }
+// Forward declaration of `PixelFormat` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class PixelFormat; }
+// Forward declaration of `TileColorMode` to properly resolve imports.
+namespace margelo::nitro::pdfium { enum class TileColorMode; }
+
+#include "LayoutMode.hpp"
+#include "PixelFormat.hpp"
+#include "TileColorMode.hpp"
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ViewportOptions).
+   */
+  struct ViewportOptions {
+  public:
+    double tileSize     SWIFT_PRIVATE;
+    double pixelRatio     SWIFT_PRIVATE;
+    LayoutMode layoutMode     SWIFT_PRIVATE;
+    double pageGap     SWIFT_PRIVATE;
+    double spreadGap     SWIFT_PRIVATE;
+    PixelFormat pixelFormat     SWIFT_PRIVATE;
+    TileColorMode colorMode     SWIFT_PRIVATE;
+
+  public:
+    explicit ViewportOptions(double tileSize, double pixelRatio, LayoutMode layoutMode, double pageGap, double spreadGap, PixelFormat pixelFormat, TileColorMode colorMode): tileSize(tileSize), pixelRatio(pixelRatio), layoutMode(layoutMode), pageGap(pageGap), spreadGap(spreadGap), pixelFormat(pixelFormat), colorMode(colorMode) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ ViewportOptions <> JS ViewportOptions (object)
+  template <>
+  struct JSIConverter<ViewportOptions> {
+    static inline ViewportOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ViewportOptions(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "tileSize")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pixelRatio")),
+        JSIConverter<LayoutMode>::fromJSI(runtime, obj.getProperty(runtime, "layoutMode")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pageGap")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "spreadGap")),
+        JSIConverter<PixelFormat>::fromJSI(runtime, obj.getProperty(runtime, "pixelFormat")),
+        JSIConverter<TileColorMode>::fromJSI(runtime, obj.getProperty(runtime, "colorMode"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ViewportOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "tileSize", JSIConverter<double>::toJSI(runtime, arg.tileSize));
+      obj.setProperty(runtime, "pixelRatio", JSIConverter<double>::toJSI(runtime, arg.pixelRatio));
+      obj.setProperty(runtime, "layoutMode", JSIConverter<LayoutMode>::toJSI(runtime, arg.layoutMode));
+      obj.setProperty(runtime, "pageGap", JSIConverter<double>::toJSI(runtime, arg.pageGap));
+      obj.setProperty(runtime, "spreadGap", JSIConverter<double>::toJSI(runtime, arg.spreadGap));
+      obj.setProperty(runtime, "pixelFormat", JSIConverter<PixelFormat>::toJSI(runtime, arg.pixelFormat));
+      obj.setProperty(runtime, "colorMode", JSIConverter<TileColorMode>::toJSI(runtime, arg.colorMode));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "tileSize"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pixelRatio"))) return false;
+      if (!JSIConverter<LayoutMode>::canConvert(runtime, obj.getProperty(runtime, "layoutMode"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pageGap"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "spreadGap"))) return false;
+      if (!JSIConverter<PixelFormat>::canConvert(runtime, obj.getProperty(runtime, "pixelFormat"))) return false;
+      if (!JSIConverter<TileColorMode>::canConvert(runtime, obj.getProperty(runtime, "colorMode"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,89 @@
+///
+/// ViewportTile.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `RenderedTile` to properly resolve imports.
+namespace margelo::nitro::pdfium { struct RenderedTile; }
+
+#include "RenderedTile.hpp"
+
+namespace margelo::nitro::pdfium {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ViewportTile).
+   */
+  struct ViewportTile {
+  public:
+    RenderedTile tile     SWIFT_PRIVATE;
+    double pageNumber     SWIFT_PRIVATE;
+    double x     SWIFT_PRIVATE;
+    double y     SWIFT_PRIVATE;
+    double width     SWIFT_PRIVATE;
+    double height     SWIFT_PRIVATE;
+
+  public:
+    explicit ViewportTile(RenderedTile tile, double pageNumber, double x, double y, double width, double height): tile(tile), pageNumber(pageNumber), x(x), y(y), width(width), height(height) {}
+  };
+
+} // namespace margelo::nitro::pdfium
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::pdfium;
+
+  // C++ ViewportTile <> JS ViewportTile (object)
+  template <>
+  struct JSIConverter<ViewportTile> {
+    static inline ViewportTile fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ViewportTile(
+        JSIConverter<RenderedTile>::fromJSI(runtime, obj.getProperty(runtime, "tile")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pageNumber")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "x")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "y")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "width")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "height"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ViewportTile& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "tile", JSIConverter<RenderedTile>::toJSI(runtime, arg.tile));
+      obj.setProperty(runtime, "pageNumber", JSIConverter<double>::toJSI(runtime, arg.pageNumber));
+      obj.setProperty(runtime, "x", JSIConverter<double>::toJSI(runtime, arg.x));
+      obj.setProperty(runtime, "y", JSIConverter<double>::toJSI(runtime, arg.y));
+      obj.setProperty(runtime, "width", JSIConverter<double>::toJSI(runtime, arg.width));
+      obj.setProperty(runtime, "height", JSIConverter<double>::toJSI(runtime, arg.height));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<RenderedTile>::canConvert(runtime, obj.getProperty(runtime, "tile"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pageNumber"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "x"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "y"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "width"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "height"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
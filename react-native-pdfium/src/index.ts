@@ -1,5 +1,30 @@
 import { NitroModules } from "react-native-nitro-modules";
 import type { PdfiumUtil } from "./specs/pdfium.nitro";
 
+export type {
+  AtlasEntry,
+  ColorScheme,
+  LayoutMode,
+  OpenTimings,
+  OutlineItem,
+  PageElement,
+  PageElementKind,
+  PixelFormat,
+  ReadyTile,
+  RenderPriority,
+  RenderQualityStats,
+  RenderSchedulerStats,
+  RenderedTile,
+  TextRange,
+  TextSegment,
+  TileCacheStats,
+  TileColorMode,
+  TileColorType,
+  TileQuality,
+  TileRequest,
+  ViewportOptions,
+  ViewportTile,
+} from "./specs/pdfium.nitro";
+
 // TODO: Export all HybridObjects here for the user
 export const PdfiumModule = NitroModules.createHybridObject<PdfiumUtil>("PdfiumUtil")
\ No newline at end of file
@@ -1,11 +1,335 @@
 import { type HybridObject } from 'react-native-nitro-modules'
 
+// Byte layout of rendered tiles. The rgb* formats match Skia's RGBA_8888 / RGB_888x color types,
+// the *x formats are opaque with an unused fourth byte.
+export type PixelFormat = 'bgra' | 'rgba' | 'bgrx' | 'rgbx'
+
+// How renderTile picks the tile encoding:
+// - color: pixelFormat as requested
+// - gray: Gray8, one byte per pixel
+// - palette: 4-bit palette, gray pages are quantized to 16 levels, color tiles are packed if they
+//   use at most 16 colors
+// - auto: Gray8 for pages detected as grayscale, palette4 for color tiles with at most 16 colors,
+//   pixelFormat otherwise
+export type TileColorMode = 'color' | 'gray' | 'palette' | 'auto'
+
+// Encoding of a rendered tile's buffer. palette4 packs two pixels per byte, each a 4-bit index
+// into RenderedTile.palette: the left pixel in the high nibble (bits 4-7), the right one in the low
+// nibble. Rows are rowBytes = ceil(width / 2) apart, an odd width leaves the last low nibble 0.
+export type TileColorType = 'bgra8888' | 'rgba8888' | 'bgrx8888' | 'rgbx8888' | 'gray8' | 'palette4'
+
+// Draft tiles render without antialiasing at half the requested resolution, for use while the
+// viewer is pinching or flinging. They come back width x height smaller and are meant to be
+// stretched over the requested rect.
+export type TileQuality = 'draft' | 'full'
+
+// Colors are 0xAARRGGBB. Paths and text are drawn in the scheme's colors on the background,
+// images keep their colors. Used for dark mode without post-processing the tiles.
+export interface ColorScheme {
+    pathFillColor: number
+    pathStrokeColor: number
+    textFillColor: number
+    textStrokeColor: number
+    backgroundColor: number
+}
+
+export interface TileRequest {
+    pageNumber: number
+    // Pixel offsets of the tile within the page rendered at scale, as for getTile
+    row: number
+    column: number
+    tileWidth: number
+    tileHeight: number
+    scale: number
+    pixelFormat: PixelFormat
+    colorMode: TileColorMode
+    // Defaults to full
+    quality?: TileQuality
+    // Cached separately from tiles without a scheme
+    colorScheme?: ColorScheme
+}
+
+export interface RenderedTile {
+    buffer: ArrayBuffer
+    width: number
+    height: number
+    rowBytes: number
+    colorType: TileColorType
+    // palette4 only: 16 entries of 4 bytes, laid out like a pixel of the request's pixelFormat
+    // (R, G, B, A for rgba, B, G, R, A for bgra). The fourth byte is alpha, always 0xff for the
+    // opaque *x formats and for gray pages, whose entries are 16 evenly spaced gray levels.
+    // Read through a Uint32Array on a little-endian device an rgba entry is 0xAABBGGRR.
+    palette?: ArrayBuffer
+    // Set when every pixel of the tile has this 0xAARRGGBB color. The buffer is then empty and
+    // the tile should be drawn as a filled rect.
+    uniformColor?: number
+    // A draft request returns a full quality tile when one is cached
+    quality: TileQuality
+}
+
+// renderTile keeps recent tiles ready to use and older ones run-length compressed.
+// hotBytes + uncompressedBytes is the effective capacity, compressedBytes what the compressed
+// tier actually uses. A compressed hit costs averageDecompressMs instead of averageRenderMs.
+export interface TileCacheStats {
+    hotTiles: number
+    hotBytes: number
+    compressedTiles: number
+    compressedBytes: number
+    uncompressedBytes: number
+    hotHits: number
+    compressedHits: number
+    misses: number
+    averageDecompressMs: number
+    averageRenderMs: number
+    diskTiles: number
+    diskBytes: number
+    diskHits: number
+    // Requests that arrived while the same tile was rendering and got that render's buffer,
+    // and the render time they saved
+    coalescedRequests: number
+    coalescedSavedMs: number
+}
+
+// Scheduled renders run one class at a time in this order: tiles on screen, search highlights,
+// thumbnails, then prefetch
+export type RenderPriority = 'visible' | 'highlight' | 'thumbnail' | 'prefetch'
+
+// A tile finished by scheduleRender, with the id scheduleRender returned and the request as run.
+// request.quality is draft if the render was downgraded.
+export interface ReadyTile {
+    id: number
+    request: TileRequest
+    tile: RenderedTile
+}
+
+// Renders are dropped when cancelled or when a background render cannot finish by its deadline,
+// downgraded when a visible one has to become a draft to make it. Waits run from scheduleRender
+// to the start of the render.
+export interface RenderSchedulerStats {
+    queueDepth: number
+    visibleQueueDepth: number
+    completed: number
+    dropped: number
+    downgraded: number
+    averageWaitMs: number
+    maxWaitMs: number
+    averageVisibleWaitMs: number
+}
+
+export interface RenderQualityStats {
+    draftTiles: number
+    upgradedTiles: number
+    pendingUpgrades: number
+    draftRenderMs: number
+    upgradeRenderMs: number
+    // Full minus draft render time, summed over the upgraded tiles
+    savedMs: number
+}
+
+// A range of characters on a page, as indexed by PDFium's text page
+export interface TextRange {
+    page: number
+    charIndex: number
+    charCount: number
+}
+
+export type PageElementKind = 'link' | 'annotation'
+
+// A tappable link or annotation. Bounds are page points with a top-left origin.
+export interface PageElement {
+    kind: PageElementKind
+    // PDFium FPDF_ANNOT_* subtype
+    subtype: number
+    annotIndex: number
+    left: number
+    top: number
+    right: number
+    bottom: number
+    // Target page of internal links, -1 otherwise
+    destPage: number
+    // Target of URI links, empty otherwise
+    uri: string
+}
+
+// A word or line of a page with its bounds in page points (top-left origin)
+export interface TextSegment {
+    charIndex: number
+    charCount: number
+    left: number
+    top: number
+    right: number
+    bottom: number
+}
+
+// An outline (bookmark) entry. getOutline flattens the tree in document order, children follow
+// their parent with a depth one higher.
+export interface OutlineItem {
+    title: string
+    // -1 if the entry does not point into the document
+    pageIndex: number
+    depth: number
+}
+
+// How the viewport lays out pages: one per row top to bottom, one per column left to right, or
+// facing pairs top to bottom. Pages are centered across the scroll direction.
+export type LayoutMode = 'vertical' | 'horizontal' | 'spread'
+
+// Layout and tiling used by renderViewport. Pages are pageGap page points apart along the scroll
+// direction, facing pages of a spread spreadGap apart. Tiles are tileSize screen points square and
+// rendered at pixelRatio pixels per point.
+export interface ViewportOptions {
+    tileSize: number
+    pixelRatio: number
+    layoutMode: LayoutMode
+    pageGap: number
+    spreadGap: number
+    pixelFormat: PixelFormat
+    colorMode: TileColorMode
+}
+
+// A tile of renderViewport and where to draw it, in screen points relative to the viewport
+export interface ViewportTile {
+    tile: RenderedTile
+    pageNumber: number
+    x: number
+    y: number
+    width: number
+    height: number
+}
+
+// Where renderAtlasBatch put a tile. slot is -1 for requests beyond the atlas capacity and for tiles
+// that failed to render. rendered is false when the tile was already in the slot from an earlier
+// batch, so its pixels need no upload.
+export interface AtlasEntry {
+    slot: number
+    x: number
+    y: number
+    width: number
+    height: number
+    rendered: boolean
+}
+
+// Milliseconds since the open call. firstPageMs and firstTileMs (time to first pixel) and
+// geometryMs are only measured by openPdfAsync.
+export interface OpenTimings {
+    loadMs: number
+    firstPageMs: number
+    firstTileMs: number
+    geometryMs: number
+}
+
 export interface PdfiumUtil extends HybridObject<{ ios: 'c++', android: 'c++' }> {
     add(a: number, b: number): number
     openPdf(filePath: string): void
     closePdf(): void
-    getTile(pageNumber: number, row: number, column: number, displayWidth: number, tileWidth: number, tileHeight: number, scale: number): ArrayBuffer
+    // Opens the document on a worker thread. onOpened is called as soon as the document and the
+    // page of initialTile are parsed, with the page count (0 if the file could not be opened) and
+    // a render of initialTile. Page sizes then stream to onPageSizes as flattened
+    // [width, height] pairs starting at firstPage, done is true for the last batch.
+    openPdfAsync(filePath: string, initialTile: TileRequest | undefined,
+                 onOpened: (pageCount: number, firstTile: RenderedTile | undefined) => void,
+                 onPageSizes: (firstPage: number, sizes: number[], done: boolean) => void): void
+    getOpenTimings(): OpenTimings
+    getTile(pageNumber: number, row: number, column: number, displayWidth: number, tileWidth: number, tileHeight: number, scale: number, pixelFormat: PixelFormat): ArrayBuffer
+    // Renders a getTile tile straight into a caller owned buffer, starting at byte offset with rows
+    // rowBytes apart, so upload buffers can be recycled instead of allocating per tile. offset and
+    // rowBytes must be multiples of 4. Returns false if the tile does not fit.
+    getTileInto(target: ArrayBuffer, offset: number, rowBytes: number, pageNumber: number, row: number, column: number,
+                tileWidth: number, tileHeight: number, scale: number, pixelFormat: PixelFormat): boolean
     getTileBgr565(pageNumber: number, row: number, column: number, displayWidth: number, tileWidth: number, tileHeight: number, scale: number): ArrayBuffer
+    renderTile(request: TileRequest): RenderedTile
+    // Defaults to 256 point tiles at pixel ratio 2, vertical layout, 10 point gaps, rgbx and color
+    setViewportOptions(options: ViewportOptions): void
+    // Geometry of count pages from firstPage, as a Float64Array of five lanes of count values each:
+    // widths, heights, left and top offsets in the viewport layout (page points), then rotation in
+    // quarter turns, -1 for pages not loaded yet. Sizes already account for rotation. One buffer
+    // replaces the per page arrays of getAllPageDimensions, read it in windows for huge documents.
+    getPageGeometry(firstPage: number, count: number): ArrayBuffer
+    // [first, last] page between two offsets along the scroll direction, in page points of the
+    // viewport layout. Empty if the range only covers gaps or lies outside the document.
+    getPageRange(start: number, end: number): number[]
+    // Size of the laid out document as [width, height] in page points
+    getLayoutSize(): number[]
+    // Scale at which the widest page (or spread) fills viewportWidth screen points
+    getFitWidthScale(viewportWidth: number): number
+    // Indices of the pages intersecting the viewport, in the coordinates of renderViewport
+    getVisiblePages(offsetX: number, offsetY: number, scale: number, width: number, height: number): number[]
+    // Every tile visible in the viewport, rendered or taken from the cache, with its destination
+    // rect. Offsets are the scroll position in screen points of the document laid out at scale.
+    renderViewport(offsetX: number, offsetY: number, scale: number, width: number, height: number): ViewportTile[]
+    // One screen aligned grid cell of the viewport layout, tileSize points square with its top
+    // left corner at (x, y). Slices of every page under the cell are rendered into a single buffer
+    // over gapColor (0xAARRGGBB), so cells spanning page boundaries need no compositing.
+    renderGridTile(x: number, y: number, scale: number, gapColor: number): RenderedTile
+    // Atlas mode: tiles are rendered into slots of one large buffer, columns x rows slots of
+    // slotSize pixels, so a frame uploads a single image. Returns that buffer, rows are
+    // columns * slotSize * 4 bytes. Reconfiguring drops the previous atlas.
+    configureAtlas(slotSize: number, columns: number, rows: number, pixelFormat: PixelFormat): ArrayBuffer
+    // Places the tiles of a frame or prefetch batch in the atlas, one entry per request. Tiles
+    // already in the atlas keep their slot, others take the least recently used one. Tiles are
+    // rendered in full quality and color, cut to the slot size.
+    renderAtlasBatch(requests: TileRequest[]): AtlasEntry[]
+    // Renders pages with thousands of objects (CAD drawings) region by region, so a zoomed in
+    // tile only processes the objects near it. Costs a one-off copy of each region on first use.
+    setLargePageMode(enabled: boolean): void
+    // Draft tiles are re-rendered at full quality in the background while the viewer is not
+    // moving. onUpgraded is called for each upgraded tile, which renderTile then serves from cache.
+    setInteractionState(moving: boolean): void
+    setTileUpgradeListener(onUpgraded: (request: TileRequest) => void): void
+    getRenderQualityStats(): RenderQualityStats
+    // Queues a renderTile on the worker thread and returns an id for cancelRender. Higher priority
+    // classes always go first, earliest deadline first within a class. deadlineMs is relative to
+    // now, 0 for none. onRendered gets undefined if the render was dropped.
+    scheduleRender(request: TileRequest, priority: RenderPriority, deadlineMs: number,
+                   onRendered?: (tile: RenderedTile | undefined) => void): number
+    // Delivers the tiles of scheduleRender that finished during each frame in one call, every
+    // frameIntervalMs (0 for 60 Hz), instead of one onRendered call per tile. Replaces the
+    // previous listener.
+    setTilesReadyListener(onTilesReady: (tiles: ReadyTile[]) => void, frameIntervalMs: number): void
+    // Drops a queued render without calling back. Returns false once it has started.
+    cancelRender(id: number): boolean
+    getRenderSchedulerStats(): RenderSchedulerStats
+    getTileCacheStats(): TileCacheStats
+    // Persists full quality tiles of renderTile in the directory, keyed by document fingerprint,
+    // so reopening a document serves its first screen without rendering. The least recently
+    // used tiles are dropped beyond maxBytes, which must be above 0. An empty directory turns the
+    // disk cache off.
+    setDiskCacheDirectory(directory: string, maxBytes: number): boolean
     getPageCount(): number
+    // One [width, height, cumulative height] array per page. Prefer getPageGeometry for large documents.
     getAllPageDimensions(): [number, number, number][]
-}
\ No newline at end of file
+    // Page sizes, outline, page labels and named destinations are written to a sidecar file per
+    // document in this directory, and read from it on the next openPdf of the same file. A missing
+    // or outdated sidecar is rebuilt in the background, the getters read the document meanwhile.
+    setSidecarDirectory(directory: string): void
+    getOutline(): OutlineItem[]
+    // Empty if the document defines no label for the page
+    getPageLabel(pageNumber: number): string
+    // Page index of a named destination, -1 if there is none
+    getNamedDestinationPage(name: string): number
+
+    // Full text index, built in the background after startTextIndex is called
+    startTextIndex(): void
+    getTextIndexProgress(): number
+    searchTextIndex(query: string, maxResults: number): TextRange[]
+    // Flattened [left, top, right, bottom] rects in page points with a top-left origin
+    getTextRects(pageNumber: number, charIndex: number, charCount: number): number[]
+
+    // Streaming search on a worker thread. Flags are PDFium's FPDF_MATCHCASE / FPDF_MATCHWHOLEWORD /
+    // FPDF_CONSECUTIVE. Pages nearest to startPage are searched first. Starting a new search or calling
+    // cancelSearch stops the previous one. Returns the id passed to onResults.
+    searchAsync(query: string, flags: number, startPage: number, resultsPerBatch: number,
+                onResults: (searchId: number, hits: TextRange[], done: boolean) => void): number
+    cancelSearch(): void
+
+    // Text hit testing backed by a per-page character grid. Coordinates are page points with a
+    // top-left origin. getCharRangesInRect returns packed Int32 [charIndex, charCount] pairs.
+    getCharIndexAtPos(pageNumber: number, x: number, y: number, tolerance: number): number
+    getCharRangesInRect(pageNumber: number, left: number, top: number, right: number, bottom: number): ArrayBuffer
+    // Word and line selection from a cached segmentation of the page text
+    getWordAt(pageNumber: number, x: number, y: number): TextSegment | undefined
+    getLinesInRect(pageNumber: number, left: number, top: number, right: number, bottom: number): TextSegment[]
+
+    // Topmost link or annotation under the point, from a lazily built per-page index
+    hitTest(pageNumber: number, x: number, y: number): PageElement | undefined
+}